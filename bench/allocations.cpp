@@ -0,0 +1,37 @@
+/*
+ OBS Accessibility
+ Copyright (C) 2025 Sam Tupy Productions <webmaster@samtupy.com>
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along
+ with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+// Replacement global allocation functions for the benchmark, see bench_hot_path(). They live in their own file so that the compiler never inlines them into the code under test, where it would pair a call to operator new with the free() inside operator delete and warn about the mismatch.
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+using namespace std;
+
+thread_local bool g_count_allocations = false;
+thread_local uint64_t g_allocations = 0;
+void* operator new(size_t size) {
+	if (g_count_allocations) g_allocations++;
+	if (void* p = malloc(size? size : 1)) return p;
+	throw bad_alloc();
+}
+void* operator new[](size_t size) { return operator new(size); }
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { operator delete(p); }
+void operator delete(void* p, size_t) noexcept { operator delete(p); }
+void operator delete[](void* p, size_t) noexcept { operator delete[](p); }
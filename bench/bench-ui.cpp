@@ -0,0 +1,113 @@
+/*
+ OBS Accessibility
+ Copyright (C) 2025 Sam Tupy Productions <webmaster@samtupy.com>
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along
+ with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+// UI thread cost of the Qt accessibility fix-ups, run against a mock of the OBS filters dialog on the offscreen platform. Output follows bench.cpp, one JSON object per case.
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <QApplication>
+#include <QCheckBox>
+#include <QDialog>
+#include <QFormLayout>
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QLineEdit>
+#include <QListWidget>
+#include <QPaintEvent>
+#include <QVBoxLayout>
+#include "interface.h"
+
+using namespace std;
+
+void fix_filters_dialog(QDialog* dlg); // interface.cpp
+void fix_property_controls(QFormLayout* layout);
+
+FILE* g_out = stdout;
+const char* g_filter = nullptr;
+template<typename F> void run(const char* name, uint64_t iterations, F&& func) {
+	if (g_filter && !strstr(name, g_filter)) return;
+	func();
+	auto start = chrono::steady_clock::now();
+	for (uint64_t i = 0; i < iterations; i++) func();
+	uint64_t total_ns = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+	fprintf(g_out, "{\"name\":\"%s\",\"iterations\":%llu,\"total_ns\":%llu,\"ns_per_op\":%.2f}\n", name, (unsigned long long)iterations, (unsigned long long)total_ns, iterations? double(total_ns) / iterations : 0.0);
+	fflush(g_out);
+}
+
+struct bench_filter : qt_event_filter {
+	bench_filter() : qt_event_filter(nullptr) {}
+	using qt_event_filter::eventFilter;
+};
+
+void add_filter_row(QListWidget* list, int index) {
+	// Same shape as the visibility rows OBS puts in its filter lists, a checkbox followed by the filter name.
+	QListWidgetItem* item = new QListWidgetItem(list);
+	QWidget* row = new QWidget();
+	QHBoxLayout* layout = new QHBoxLayout(row);
+	layout->addWidget(new QCheckBox());
+	layout->addWidget(new QLabel(QString("Filter %1").arg(index)));
+	list->setItemWidget(item, row);
+}
+
+int main(int argc, char** argv) {
+	for (int i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "--out") && i + 1 < argc) g_out = fopen(argv[++i], "w");
+		else if (!strcmp(argv[i], "--filter") && i + 1 < argc) g_filter = argv[++i];
+	}
+	if (!g_out) {
+		perror("--out");
+		return 1;
+	}
+	if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) qputenv("QT_QPA_PLATFORM", "offscreen");
+	QApplication app(argc, argv);
+	QDialog dlg;
+	dlg.setObjectName("OBSBasicFilters");
+	QVBoxLayout* layout = new QVBoxLayout(&dlg);
+	QLabel* label = new QLabel("Effect Filters");
+	label->setObjectName("label_2");
+	QListWidget* list = new QListWidget();
+	list->setObjectName("effectFilters");
+	layout->addWidget(label);
+	layout->addWidget(list);
+	for (int i = 0; i < 500; i++) add_filter_row(list, i);
+	bench_filter filter;
+	app.installEventFilter(&filter);
+	dlg.show();
+	app.processEvents();
+	// Before the watcher existed every paint of the dialog paid for a full pass, now a paint is rejected by the application filter on its type alone.
+	run("ui.filters.fix_pass.500", 1000, [&] { fix_filters_dialog(&dlg); });
+	QPaintEvent paint(dlg.rect());
+	run("ui.filter.paint", 1000000, [&] { filter.eventFilter(&dlg, &paint); });
+	QEvent move(QEvent::Move);
+	run("ui.filter.unhandled", 1000000, [&] { filter.eventFilter(list, &move); });
+	// Fifty filters added in one turn of the event loop should cost a single deferred pass.
+	int next = 500;
+	run("ui.filters.add_batch.50", 20, [&] {
+		for (int i = 0; i < 50; i++) add_filter_row(list, next++);
+		app.processEvents();
+	});
+	// A properties container the size of a browser source with every option exposed, which OBS rebuilds and has relabeled on every refresh.
+	QWidget container;
+	container.setObjectName("PropertiesContainer");
+	QFormLayout* form = new QFormLayout(&container);
+	for (int i = 0; i < 300; i++) form->addRow(QString("Option %1").arg(i), new QLineEdit());
+	run("ui.properties.relabel.300", 1000, [&] { fix_property_controls(form); });
+	app.removeEventFilter(&filter);
+	if (g_out != stdout) fclose(g_out);
+	return 0;
+}
@@ -0,0 +1,1210 @@
+/*
+ OBS Accessibility
+ Copyright (C) 2025 Sam Tupy Productions <webmaster@samtupy.com>
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along
+ with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+// Headless benchmark harness for the plugin core. Every case prints one JSON object per line to stdout, or to the file given with --out, so that runs can be diffed or fed into regression tracking. Pass --filter text to only run cases whose name contains that text, and --wav file to keep the output of the offline render case.
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+#include <miniaudio.h>
+#include <obs.h>
+#include <obs.hpp>
+#include <obs-module.h>
+#include <obs-stub.h>
+#ifndef _WIN32
+	#include <sys/socket.h>
+	#include <sys/un.h>
+	#include <unistd.h>
+#endif
+#include "api.h"
+#include "audio.h"
+#include "config.h"
+#include "dispatch.h"
+#include "events.h"
+#include "history.h"
+#include "levels.h"
+#include "logs.h"
+#include "monitor.h"
+#include "rules.h"
+#include "scenes.h"
+#include "speech.h"
+#include "stream.h"
+#include "text.h"
+#include "tones.h"
+#include "video.h"
+
+using namespace std;
+
+// Counts heap allocations made by the current thread while g_count_allocations is set, see allocations.cpp and bench_hot_path().
+extern thread_local bool g_count_allocations;
+extern thread_local uint64_t g_allocations;
+// Keeps a benchmarked result alive without a local that is never read.
+template<typename T> T volatile g_sink = {};
+template<typename T> void keep(T value) { g_sink<T> = value; }
+
+FILE* g_out = stdout;
+const char* g_filter = nullptr;
+const char* g_wav = nullptr;
+const char* g_log = nullptr;
+bool wants(const char* name) { return !g_filter || strstr(name, g_filter); }
+template<typename F> void run(const char* name, uint64_t iterations, F&& func, uint64_t ops_per_iteration = 1, bool warmup = true) {
+	if (!wants(name)) return;
+	if (warmup) func(); // Warm caches and lazy initialization before timing.
+	auto start = chrono::steady_clock::now();
+	for (uint64_t i = 0; i < iterations; i++) func();
+	uint64_t total_ns = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+	uint64_t ops = iterations * ops_per_iteration;
+	fprintf(g_out, "{\"name\":\"%s\",\"iterations\":%llu,\"total_ns\":%llu,\"ns_per_op\":%.2f}\n", name, (unsigned long long)ops, (unsigned long long)total_ns, ops? double(total_ns) / ops : 0.0);
+	fflush(g_out);
+}
+
+void bench_event_lookup() {
+	vector<string> ids, misses;
+	get_event_types(ids);
+	for (const string& id : ids) misses.push_back(id + "_unknown");
+	size_t i = 0;
+	run("event_lookup.hit", 1000000, [&] { keep(get_event_type(ids[i++ % ids.size()])); });
+	run("event_lookup.miss", 1000000, [&] { keep(get_event_type(misses[i++ % misses.size()])); });
+	run("event_lookup.frontend", 1000000, [&] { keep(get_event_type(obs_frontend_event(i++ % (OBS_FRONTEND_EVENT_CANVAS_REMOVED + 1)))); });
+}
+
+void bench_templates() {
+	obs_source_t* src = stub_create_source("bench_input", "Microphone");
+	calldata_t cd;
+	calldata_init(&cd);
+	calldata_set_ptr(&cd, "source", src);
+	calldata_set_bool(&cd, "muted", true);
+	calldata_set_string(&cd, "new_name", "Desktop Audio");
+	run("replace_obs_variables.plain", 200000, [&] { replace_obs_variables("Recording started", &cd); });
+	run("replace_obs_variables.source", 200000, [&] { replace_obs_variables("{source.name} shown", &cd); });
+	run("replace_obs_variables.mixed", 200000, [&] { replace_obs_variables("{source.name} {muted:muted:unmuted} at {source.volume%} percent, renamed to {new_name}", &cd); });
+	run("replace_obs_variables.escaped", 200000, [&] { replace_obs_variables("\\{literal\\} {source.typeid}", &cd); });
+	calldata_free(&cd);
+	obs_source_release(src);
+}
+
+void bench_properties() {
+	// Opening the global settings dialog, which builds the events combo from the per locale cache.
+	event_source_data* src = get_audio_event_source();
+	run("properties.open", 2000, [&] { obs_properties_destroy(event_source_getprops(src)); });
+	// What a settings change costs the UI thread now that the file itself is written in the background.
+	run("config.mark_dirty", 2000, [] { mark_config_dirty(); });
+	// A keystroke in the event search reaches event_source_update like any other change, but leaves the applied settings and the config file alone.
+	OBSDataAutoRelease settings = obs_source_get_settings(src->source);
+	int keystroke = 0;
+	run("config.update.dialog_only", 2000, [&] {
+		obs_data_set_string(settings, "event_search", keystroke++ % 2? "scene" : "scen");
+		event_source_update(src, settings);
+	});
+	obs_data_set_string(settings, "event_search", "");
+	event_source_update(src, settings);
+}
+
+bool bench_speech() {
+	// Speech through the built in loopback backend and through the stub prism backend, then the numbers automatic selection works from.
+	set_speech_backend(SPEECH_LOOPBACK_NAME);
+	run("speech.loopback", 100000, [] { speak("Recording started", false); });
+	bool recorded = !wants("speech.loopback") || get_loopback_utterances().size() == SPEECH_LOOPBACK_HISTORY;
+	if (!recorded) fprintf(stderr, "loopback backend did not record utterances\n");
+	set_speech_backend("");
+	run("speech.auto", 100000, [] { speak("Recording started", false); });
+	if (!wants("speech")) return recorded;
+	for (const speech_backend_stats& b : get_speech_backend_stats()) fprintf(g_out, "{\"name\":\"speech.backend\",\"backend\":\"%s\",\"calls\":%llu,\"failures\":%llu,\"average_ms\":%.4f,\"init_ms\":%.4f,\"selected\":%s}\n", b.name.c_str(), (unsigned long long)b.calls, (unsigned long long)b.failures, b.average_ms, b.init_ms, b.selected? "true" : "false");
+	return recorded;
+}
+
+void bench_play() {
+	// Fan out across additional user created event sources, as if they had been added to scenes.
+	vector<obs_source_t*> sources;
+	run("play.fanout.1", 200, [] { play("source_show"); });
+	for (int i = 0; i < 7; i++) sources.push_back(obs_source_create("accessibility_event_audio", "bench events", nullptr, nullptr));
+	run("play.fanout.8", 200, [] { play("source_show"); });
+	run("play.missing_earcon.8", 200, [] { play("source_create"); });
+	for (obs_source_t* s : sources) obs_source_release(s);
+	// Placing an earcon on the frame matching its event's arrival only adds a read of the mixer clock.
+	event_type* event = get_event_type("source_show");
+	run("play.scheduled.1", 200, [&] { play(event, os_gettime_ns()); });
+	if (!wants("play.schedule_late")) return;
+	// Events dispatched at a steady pace all make the default 20 ms latency target, while a 1 ms target is shorter than a block and is missed by nearly every one.
+	event_source_data* d = get_audio_event_source();
+	obs_source_t* src = stub_create_source("bench_input", "Camera");
+	calldata_t cd;
+	calldata_init(&cd);
+	calldata_set_ptr(&cd, "source", src);
+	uint64_t late[2];
+	for (int latency : {20, 1}) {
+		set_earcon_latency(latency);
+		uint64_t before = d->late_voices;
+		for (int i = 0; i < 100; i++) {
+			stub_emit_signal("source_show", &cd);
+			this_thread::sleep_for(chrono::microseconds(1700));
+		}
+		this_thread::sleep_for(chrono::milliseconds(50));
+		late[latency == 20? 0 : 1] = d->late_voices - before;
+	}
+	set_earcon_latency(20);
+	fprintf(g_out, "{\"name\":\"play.schedule_late\",\"events\":100,\"late_at_20ms\":%llu,\"late_at_1ms\":%llu}\n", (unsigned long long)late[0], (unsigned long long)late[1]);
+	fflush(g_out);
+	calldata_free(&cd);
+	obs_source_release(src);
+}
+
+bool bench_direct_output() {
+	// Miniaudio's null backend keeps time like a real device without making a sound, so the global source can be handed to it and back on any machine.
+	if (!wants("direct_output")) return true;
+	event_source_data* d = get_audio_event_source();
+	event_type* event = get_event_type("source_show");
+	auto late_at = [&](int latency) {
+		// A 5 ms target is shorter than a 10 ms mixer block, but longer than the device's period.
+		set_earcon_latency(latency);
+		uint64_t before = d->late_voices;
+		for (int i = 0; i < 100; i++) {
+			play(event, os_gettime_ns());
+			this_thread::sleep_for(chrono::microseconds(1700));
+		}
+		set_earcon_latency(20);
+		return d->late_voices - before;
+	};
+	uint64_t late_obs = late_at(5);
+	auto start = chrono::steady_clock::now();
+	bool opened = set_direct_output(true, 5, true);
+	uint64_t open_ns = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+	this_thread::sleep_for(chrono::milliseconds(50));
+	uint32_t period = d->clock_block;
+	uint64_t frame = d->clock_frame;
+	this_thread::sleep_for(chrono::milliseconds(100));
+	uint64_t frames = d->clock_frame - frame;
+	uint64_t late_direct = late_at(5);
+	run("direct_output.play", 200, [&] { play(event, os_gettime_ns()); });
+	set_direct_output(false);
+	this_thread::sleep_for(chrono::milliseconds(50));
+	fprintf(g_out, "{\"name\":\"direct_output\",\"opened\":%s,\"open_ns\":%llu,\"period_frames\":%u,\"frames_per_100ms\":%llu,\"late_at_5ms_obs\":%llu,\"late_at_5ms_direct\":%llu,\"mixer_block_after\":%u}\n", opened? "true" : "false", (unsigned long long)open_ns, period, (unsigned long long)frames, (unsigned long long)late_obs, (unsigned long long)late_direct, d->clock_block.load());
+	fflush(g_out);
+	bool handed_back = opened && period == 240 && d->clock_block == EVENT_SOURCE_BLOCK_FRAMES;
+	if (!handed_back) fprintf(stderr, "direct output did not take over the global source and hand it back\n");
+	return handed_back;
+}
+
+void bench_mix() {
+	// Mirrors the engine configuration of event_source_create so the numbers reflect the per-block cost of event_source_thread.
+	char* earcon = obs_module_file("earcon/source_show.wav");
+	if (!earcon) return;
+	for (int voices : {0, 4, 16, 64}) {
+		ma_engine_config cfg = ma_engine_config_init();
+		cfg.noDevice = MA_TRUE;
+		cfg.channels = 2;
+		cfg.sampleRate = 48000;
+		ma_engine engine;
+		if (ma_engine_init(&cfg, &engine) != MA_SUCCESS) break;
+		vector<ma_sound> sounds(voices);
+		for (ma_sound& s : sounds) {
+			ma_sound_init_from_file(&engine, earcon, MA_SOUND_FLAG_DECODE, nullptr, nullptr, &s);
+			ma_sound_set_looping(&s, MA_TRUE);
+			ma_sound_start(&s);
+		}
+		float buffer[960];
+		string name = "mix.block480.voices" + to_string(voices);
+		run(name.c_str(), 20000, [&] {
+			ma_uint64 frames_read;
+			ma_engine_read_pcm_frames(&engine, buffer, 480, &frames_read);
+		});
+		for (ma_sound& s : sounds) ma_sound_uninit(&s);
+		ma_engine_uninit(&engine);
+	}
+	bfree(earcon);
+}
+
+bool bench_earcon_policy() {
+	// Which earcons are streamed: a short cue, one too large to decode whole, and a small file that still plays for too long.
+	if (!wants("earcon_policy")) return true;
+	filesystem::path dir = filesystem::temp_directory_path() / "obs-accessibility-bench-earcons";
+	filesystem::create_directories(dir);
+	string short_cue = (dir / "short.wav").string(), large = (dir / "large.wav").string(), long_bed = (dir / "long.wav").string();
+	write_wav(short_cue, vector<float>(48000, 0.0f));
+	write_wav(large, vector<float>(48000 * 2 * 6, 0.0f));
+	{
+		// 8 bit mono at 8 kHz keeps 15 seconds down to 120 KB.
+		uint32_t frames = 8000 * 15, riff_size = 36 + frames, fmt_size = 16, rate = 8000;
+		uint16_t format = 1, channels = 1, block_align = 1, bits = 8;
+		FILE* f = fopen(long_bed.c_str(), "wb");
+		if (f) {
+			fwrite("RIFF", 1, 4, f); fwrite(&riff_size, 4, 1, f); fwrite("WAVEfmt ", 1, 8, f); fwrite(&fmt_size, 4, 1, f);
+			fwrite(&format, 2, 1, f); fwrite(&channels, 2, 1, f); fwrite(&rate, 4, 1, f); fwrite(&rate, 4, 1, f); fwrite(&block_align, 2, 1, f); fwrite(&bits, 2, 1, f);
+			fwrite("data", 1, 4, f); fwrite(&frames, 4, 1, f);
+			vector<uint8_t> silence(frames, 128);
+			fwrite(silence.data(), 1, silence.size(), f);
+			fclose(f);
+		}
+	}
+	auto start = chrono::steady_clock::now();
+	bool short_streamed = should_stream_earcon(short_cue), large_streamed = should_stream_earcon(large), long_streamed = should_stream_earcon(long_bed);
+	uint64_t first_ns = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+	fprintf(g_out, "{\"name\":\"earcon_policy\",\"short_streamed\":%s,\"large_streamed\":%s,\"long_streamed\":%s,\"first_ns\":%llu}\n", short_streamed? "true" : "false", large_streamed? "true" : "false", long_streamed? "true" : "false", (unsigned long long)first_ns);
+	fflush(g_out);
+	bool picked = !short_streamed && large_streamed && long_streamed;
+	if (!picked) fprintf(stderr, "earcon streaming policy picked the wrong files\n");
+	// Every settings change asks again for every earcon of every event source, which only costs a stat once the answer is cached.
+	run("earcon_policy.cached", 10000, [&] { should_stream_earcon(long_bed); });
+	filesystem::remove_all(dir);
+	return picked;
+}
+
+bool bench_offline_render() {
+	// A minute of alternating earcons every 100 ms, then a burst twice the size of the voice limit all landing on the same frame.
+	vector<earcon_trigger> script;
+	for (uint64_t frame = 0; frame < 48000 * 60; frame += 4800) script.push_back({frame, script.size() % 2? "source_hide" : "source_show", 0.5f});
+	vector<float> out;
+	run("offline_render.60s", 5, [&] { render_offline(script, 48000 * 60, out); }, 60);
+	if (g_wav && wants("offline_render.60s")) write_wav(g_wav, out);
+	vector<earcon_trigger> burst;
+	for (int i = 0; i < EVENT_SOURCE_MAX_VOICES * 2; i++) burst.push_back({0, "source_show"});
+	run("offline_render.burst.1s", 20, [&] { render_offline(burst, 48000, out); });
+	if (!wants("offline_render.offset")) return true;
+	// A trigger partway through a block must not be heard before its frame.
+	render_offline({{1000, "source_show"}}, 4800, out);
+	int64_t onset = -1;
+	for (size_t i = 0; i < out.size() && onset < 0; i++) if (out[i] != 0.0f) onset = i / 2;
+	fprintf(g_out, "{\"name\":\"offline_render.offset\",\"trigger\":1000,\"onset\":%lld}\n", (long long)onset);
+	fflush(g_out);
+	bool on_time = onset < 0 || onset >= 1000;
+	if (!on_time) fprintf(stderr, "offline earcon started before its frame\n");
+	return on_time;
+}
+
+void bench_load_shedding() {
+	// Drives the monitor by hand through overload and recovery, checking that low priority signals are shed in between and that both transitions are announced.
+	if (!wants("load_shedding")) return;
+	shutdown_monitor();
+	obs_source_t* src = stub_create_source("bench_input", "Camera");
+	calldata_t cd;
+	calldata_init(&cd);
+	calldata_set_ptr(&cd, "source", src);
+	uint64_t utterances = stub_utterance_count();
+	for (int i = 0; i < MONITOR_SHED_AFTER; i++) {
+		stub_set_load(97.0, 60, 10, 0);
+		monitor_tick();
+	}
+	bool shedding = is_shedding_load();
+	uint64_t shed = get_shed_event_count();
+	get_event_type("source_show")->set_low_priority(true); // An event with something to say, marked as configured in the event edit group.
+	auto start = chrono::steady_clock::now();
+	for (int i = 0; i < 10000; i++) stub_emit_signal("source_show", &cd);
+	uint64_t total_ns = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+	shed = get_shed_event_count() - shed;
+	refresh_event_cache();
+	for (int i = 0; i < MONITOR_RECOVER_AFTER; i++) {
+		stub_set_load(10.0, 60, 0, 0);
+		monitor_tick();
+	}
+	shutdown_dispatch(); // Drains the queue so the announcements have been spoken.
+	init_dispatch();
+	fprintf(g_out, "{\"name\":\"load_shedding\",\"shedding\":%s,\"recovered\":%s,\"shed\":%llu,\"ns_per_op\":%.2f,\"announcements\":%llu}\n", shedding? "true" : "false", is_shedding_load()? "false" : "true", (unsigned long long)shed, total_ns / 10000.0, (unsigned long long)(stub_utterance_count() - utterances));
+	fflush(g_out);
+	calldata_free(&cd);
+	obs_source_release(src);
+}
+
+bool bench_stats() {
+	// The health snapshot readers and templates, fed by two hand driven monitor samples of a live stream and recording, then a health hotkey press spoken through dispatch.
+	if (!wants("stats")) return true;
+	shutdown_monitor();
+	stub_set_load(20.0, 60, 0, 0);
+	stub_set_output(true, true, 3000, 6, 10000000, 0.1f);
+	stub_set_output(false, true, 3000, 0, 50000000);
+	refresh_monitored_outputs(); // As the UI thread does when an output starts.
+	monitor_tick();
+	stub_set_output(true, true, 3060, 12, 10750000, 0.1f);
+	stub_set_output(false, true, 3060, 0, 52500000);
+	monitor_tick();
+	run("stats.snapshot", 1000000, [] { get_obs_stats(); });
+	string message = get_event_type("stream_health")->get_default_message();
+	run("stats.template.stream_health", 100000, [&] { replace_obs_variables(message, nullptr); });
+	string rendered = replace_obs_variables(message + ". " + get_event_type("system_stats")->get_default_message(), nullptr);
+	bool valid = rendered.find("<invalid") == string::npos;
+	if (!valid) fprintf(stderr, "stats template failed: %s\n", rendered.c_str());
+	uint64_t utterances = stub_utterance_count();
+	bool pressed = stub_press_hotkey("announce_stream_health") && stub_press_hotkey("announce_record_health");
+	// shutdown_dispatch() discards whatever is still queued, so wait for the dispatch thread to speak both instead.
+	for (int i = 0; i < 1000 && stub_utterance_count() - utterances < 2; i++) this_thread::sleep_for(chrono::milliseconds(1));
+	fprintf(g_out, "{\"name\":\"stats.hotkeys\",\"pressed\":%s,\"announcements\":%llu}\n", pressed? "true" : "false", (unsigned long long)(stub_utterance_count() - utterances));
+	fflush(g_out);
+	stub_set_output(true, false, 0, 0, 0);
+	stub_set_output(false, false, 0, 0, 0);
+	return valid;
+}
+
+bool bench_levels() {
+	// The peak and RMS kernel over the block sizes OBS hands capture callbacks and common channel layouts, checked against a plain loop.
+	vector<vector<float>> planes(8, vector<float>(1024));
+	for (size_t c = 0; c < planes.size(); c++) {
+		for (size_t i = 0; i < planes[c].size(); i++) planes[c][i] = 0.5f * sinf(float(i * (c + 1)) * 0.05f);
+	}
+	planes[1][777] = -0.97f;
+	const float* pointers[8];
+	for (size_t c = 0; c < 8; c++) pointers[c] = planes[c].data();
+	bool matched = true;
+	for (size_t frames : {480, 1024}) {
+		for (size_t channels : {1, 2, 6, 8}) {
+			float peak = 0.0f;
+			double sum = 0.0;
+			for (size_t c = 0; c < channels; c++) {
+				for (size_t i = 0; i < frames; i++) {
+					peak = max(peak, fabsf(planes[c][i]));
+					sum += planes[c][i] * planes[c][i];
+				}
+			}
+			audio_levels levels = measure_audio_levels(pointers, channels, frames);
+			if (levels.peak != peak || fabs(levels.rms - sqrt(sum / (channels * frames))) > 1e-5) {
+				fprintf(stderr, "audio level kernel mismatch at %zu frames, %zu channels\n", frames, channels);
+				matched = false;
+			}
+			string name = "levels.kernel." + to_string(frames) + "x" + to_string(channels);
+			run(name.c_str(), 200000, [&] { keep(measure_audio_levels(pointers, channels, frames).rms); });
+		}
+	}
+	// A watched source going silent for longer than the configured time, then coming back clipping, fed through its capture callbacks in 1024 frame blocks.
+	if (!wants("levels.watch")) return matched;
+	obs_source_t* src = stub_create_source("bench_input", "Bench Mic");
+	set_level_sources({"Bench Mic"});
+	set_level_silence(-60, 2);
+	vector<float> quiet(1024, 0.0f), loud(1024);
+	for (size_t i = 0; i < loud.size(); i++) loud[i] = i % 8 < 4? 1.0f : -1.0f;
+	audio_data block = {};
+	uint64_t utterances = stub_utterance_count();
+	auto feed = [&](vector<float>& samples, int blocks) {
+		block.data[0] = block.data[1] = reinterpret_cast<uint8_t*>(samples.data());
+		block.frames = uint32_t(samples.size());
+		for (int i = 0; i < blocks; i++) stub_capture_audio(src, &block, false);
+	};
+	auto start = chrono::steady_clock::now();
+	feed(quiet, 3 * 48000 / 1024);
+	feed(loud, 48000 / 1024);
+	uint64_t total_ns = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+	uint64_t blocks = 3 * 48000 / 1024 + 48000 / 1024;
+	for (int i = 0; i < 1000 && stub_utterance_count() - utterances < 3; i++) this_thread::sleep_for(chrono::milliseconds(1));
+	fprintf(g_out, "{\"name\":\"levels.watch\",\"blocks\":%llu,\"ns_per_op\":%.2f,\"announcements\":%llu}\n", (unsigned long long)blocks, double(total_ns) / blocks, (unsigned long long)(stub_utterance_count() - utterances));
+	fflush(g_out);
+	set_level_sources({});
+	obs_source_release(src);
+	return matched;
+}
+
+bool bench_video() {
+	// The luma and frame difference kernel at the monitor's resolution and at twice it, then synthetic program output through the raw video callback.
+	vector<uint8_t> frame(VIDEO_MONITOR_WIDTH * 2 * VIDEO_MONITOR_HEIGHT * 2), previous(frame.size());
+	for (size_t i = 0; i < frame.size(); i++) {
+		frame[i] = uint8_t(i * 7);
+		previous[i] = uint8_t(i * 7 + (i % 5 == 0));
+	}
+	video_frame_stats stats = measure_video_frame(frame.data(), 37, previous.data(), 37, 37, 11);
+	uint64_t sum = 0, difference = 0;
+	for (size_t i = 0; i < 37 * 11; i++) {
+		sum += frame[i];
+		difference += frame[i] != previous[i];
+	}
+	bool matched = stats.luma == sum / (37.0 * 11) && stats.difference == difference / (37.0 * 11);
+	if (!matched) fprintf(stderr, "video frame kernel mismatch\n");
+	run("video.kernel.160x90", 200000, [&] { keep(measure_video_frame(frame.data(), VIDEO_MONITOR_WIDTH, previous.data(), VIDEO_MONITOR_WIDTH, VIDEO_MONITOR_WIDTH, VIDEO_MONITOR_HEIGHT).luma); });
+	run("video.kernel.320x180", 50000, [&] { keep(measure_video_frame(frame.data(), VIDEO_MONITOR_WIDTH * 2, previous.data(), VIDEO_MONITOR_WIDTH * 2, VIDEO_MONITOR_WIDTH * 2, VIDEO_MONITOR_HEIGHT * 2).luma); });
+	if (!wants("video.watch")) return matched;
+	// 60 fps output going black, back to moving, frozen, then moving again, which should announce each change.
+	set_video_monitor(true);
+	// Five prepared moving frames, so that every frame the divisor lets through differs from the last one analyzed.
+	vector<vector<uint8_t>> moving(5, vector<uint8_t>(VIDEO_MONITOR_WIDTH * VIDEO_MONITOR_HEIGHT));
+	for (size_t f = 0; f < moving.size(); f++) {
+		for (size_t p = 0; p < moving[f].size(); p++) moving[f][p] = uint8_t(p + f * 40);
+	}
+	vector<uint8_t> black(moving[0].size(), 0), still(moving[0].size());
+	for (size_t i = 0; i < still.size(); i++) still[i] = uint8_t(64 + i % 128);
+	video_data data = {};
+	data.linesize[0] = VIDEO_MONITOR_WIDTH;
+	uint64_t timestamp = 0, frames = 0, utterances = stub_utterance_count();
+	auto feed = [&](vector<uint8_t>* pixels, double seconds) {
+		for (int i = 0; i < int(seconds * 60); i++, frames++) {
+			data.data[0] = pixels? pixels->data() : moving[frames % moving.size()].data();
+			data.timestamp = timestamp += 1000000000 / 60;
+			stub_output_video(&data);
+		}
+	};
+	auto start = chrono::steady_clock::now();
+	feed(nullptr, 1);
+	feed(&black, VIDEO_BLACK_SECONDS + 1);
+	feed(nullptr, 1);
+	feed(&still, VIDEO_FROZEN_SECONDS + 1);
+	feed(nullptr, 1);
+	uint64_t total_ns = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+	for (int i = 0; i < 1000 && stub_utterance_count() - utterances < 4; i++) this_thread::sleep_for(chrono::milliseconds(1));
+	set_video_monitor(false);
+	fprintf(g_out, "{\"name\":\"video.watch\",\"frames\":%llu,\"ns_per_op\":%.2f,\"announcements\":%llu,\"detached\":%s}\n", (unsigned long long)frames, double(total_ns) / frames, (unsigned long long)(stub_utterance_count() - utterances), stub_raw_video_callback_count()? "false" : "true");
+	fflush(g_out);
+	return matched;
+}
+
+bool bench_scenes() {
+	// Listing a scene the size of a busy production from the mirror against walking it live, then changes made through libobs checked against what the mirror reports.
+	obs_source_info audio_input = {};
+	audio_input.id = "bench_audio_input";
+	audio_input.type = OBS_SOURCE_TYPE_INPUT;
+	audio_input.output_flags = OBS_SOURCE_AUDIO;
+	obs_register_source(&audio_input);
+	obs_scene_t* scene = obs_scene_create("Bench Scene");
+	obs_source_t* scene_source = obs_scene_get_source(scene);
+	vector<obs_source_t*> sources;
+	vector<obs_sceneitem_t*> items;
+	for (int i = 0; i < 500; i++) {
+		sources.push_back(stub_create_source(i % 4? "bench_input" : "bench_audio_input", ("Source " + to_string(i)).c_str()));
+		items.push_back(obs_scene_add(scene, sources.back()));
+	}
+	stub_set_current_scene(scene_source);
+	auto walk = [&](vector<scene_item_state>& out) {
+		out.clear();
+		obs_scene_enum_items(scene, [](obs_scene_t*, obs_sceneitem_t* item, void* param) {
+			obs_source_t* source = obs_sceneitem_get_source(item);
+			auto out = static_cast<vector<scene_item_state>*>(param);
+			out->push_back({obs_sceneitem_get_id(item), obs_source_get_name(source), obs_sceneitem_visible(item), obs_source_muted(source), (obs_source_get_output_flags(source) & OBS_SOURCE_AUDIO) != 0, obs_source_get_volume(source)});
+			return true;
+		}, &out);
+		reverse(out.begin(), out.end());
+	};
+	vector<scene_item_state> live, mirrored;
+	run("scenes.items.enum.500", 2000, [&] { walk(live); });
+	run("scenes.items.mirror.500", 2000, [&] { get_scene_items(scene_source, mirrored); });
+	run("scenes.template.500", 2000, [&] { replace_obs_variables("{scene.name}: {scene.items}", nullptr); });
+	bool visible = true;
+	run("scenes.update.visible", 100000, [&] { obs_sceneitem_set_visible(items[1], visible = !visible); });
+	if (!wants("scenes.consistent")) {
+		stub_set_current_scene(nullptr);
+		for (obs_source_t* source : sources) obs_source_release(source);
+		obs_scene_release(scene);
+		return true;
+	}
+	obs_sceneitem_set_visible(items[10], false);
+	obs_source_set_name(sources[20], "Renamed");
+	obs_source_set_volume(sources[0], 0.5f);
+	obs_source_set_muted(sources[4], true);
+	obs_sceneitem_remove(items[499]);
+	obs_scene_add(scene, sources[499]);
+	walk(live);
+	bool consistent = get_scene_items(scene_source, mirrored) && live.size() == mirrored.size();
+	for (size_t i = 0; consistent && i < live.size(); i++) consistent = live[i].id == mirrored[i].id && live[i].name == mirrored[i].name && live[i].visible == mirrored[i].visible && live[i].muted == mirrored[i].muted && live[i].volume == mirrored[i].volume;
+	if (!consistent) fprintf(stderr, "scene mirror mismatch\n");
+	uint64_t utterances = stub_utterance_count();
+	bool pressed = stub_press_hotkey("announce_scene_items");
+	for (int i = 0; i < 1000 && stub_utterance_count() - utterances < 1; i++) this_thread::sleep_for(chrono::milliseconds(1));
+	fprintf(g_out, "{\"name\":\"scenes.consistent\",\"items\":%zu,\"consistent\":%s,\"pressed\":%s,\"announcements\":%llu}\n", mirrored.size(), consistent? "true" : "false", pressed? "true" : "false", (unsigned long long)(stub_utterance_count() - utterances));
+	fflush(g_out);
+	stub_set_current_scene(nullptr);
+	for (obs_source_t* source : sources) obs_source_release(source);
+	obs_scene_release(scene);
+	return consistent;
+}
+
+void set_event_message(const char* id, const char* message) {
+	OBSDataAutoRelease config = get_config();
+	OBSDataAutoRelease events = obs_data_get_obj(config, "events");
+	if (!events) {
+		events = obs_data_create();
+		obs_data_set_obj(config, "events", events);
+	}
+	OBSDataAutoRelease event = obs_data_get_obj(events, id);
+	if (!event) {
+		event = obs_data_create();
+		obs_data_set_obj(events, id, event);
+	}
+	if (message) obs_data_set_string(event, "message", message);
+	else obs_data_erase(event, "message");
+}
+
+bool bench_destroyed_source() {
+	// source_destroy arrives once a source has no references left, so the dispatch thread only has the identity copied from it when the signal was raised.
+	if (!wants("destroyed_source")) return true;
+	set_event_message("source_destroy", "{source.name} removed");
+	refresh_event_cache();
+	uint64_t utterances = stub_utterance_count();
+	obs_source_release(stub_create_source("bench_input", "Doomed camera"));
+	for (int i = 0; i < 1000 && stub_utterance_count() == utterances; i++) this_thread::sleep_for(chrono::milliseconds(1));
+	bool named = stub_utterance_count() > utterances && string(stub_last_utterance()) == "Doomed camera removed";
+	set_event_message("source_destroy", nullptr);
+	refresh_event_cache();
+	fprintf(g_out, "{\"name\":\"destroyed_source\",\"named\":%s}\n", named? "true" : "false");
+	fflush(g_out);
+	if (!named) fprintf(stderr, "a destroyed source's name was lost on the way to the dispatch thread\n");
+	return named;
+}
+
+bool bench_prerender() {
+	// Studio mode transitions between two scenes, timed from the frontend event to the message reaching the speech backend, first rendered on the dispatch thread and then prerendered when the preview was picked.
+	if (!wants("prerender")) return true;
+	const char* message = "{scene.name}: {scene.items}";
+	set_event_message("scene_changed", message);
+	set_event_message("transition_stopped", message);
+	refresh_event_cache();
+	obs_scene_t* scenes[3] = {obs_scene_create("Starting Soon"), obs_scene_create("Gameplay"), obs_scene_create("Scripted")};
+	vector<obs_source_t*> sources;
+	for (int i = 0; i < 60; i++) {
+		sources.push_back(stub_create_source("bench_input", ("Layer " + to_string(i)).c_str()));
+		obs_scene_add(scenes[i % 2], sources.back());
+	}
+	auto announce = [&](obs_frontend_event event) {
+		uint64_t utterances = stub_utterance_count();
+		auto start = chrono::steady_clock::now();
+		stub_emit_frontend_event(event);
+		for (int i = 0; i < 1000000 && stub_utterance_count() == utterances; i++) this_thread::yield();
+		return uint64_t(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count());
+	};
+	bool correct = true;
+	auto transitions = [&](const char* name, bool studio_mode) {
+		uint64_t total_ns = 0;
+		int count = 1000;
+		for (int i = 0; i < count; i++) {
+			obs_source_t* program = obs_scene_get_source(scenes[i % 2]), *preview = obs_scene_get_source(scenes[(i + 1) % 2]);
+			stub_set_current_scene(program);
+			stub_set_preview_scene(studio_mode? preview : nullptr);
+			stub_emit_frontend_event(OBS_FRONTEND_EVENT_PREVIEW_SCENE_CHANGED);
+			stub_set_current_scene(preview);
+			string expected = replace_obs_variables(message, nullptr);
+			total_ns += announce(OBS_FRONTEND_EVENT_SCENE_CHANGED);
+			correct = correct && expected == stub_last_utterance();
+			total_ns += announce(OBS_FRONTEND_EVENT_TRANSITION_STOPPED);
+			correct = correct && expected == stub_last_utterance();
+		}
+		fprintf(g_out, "{\"name\":\"%s\",\"iterations\":%d,\"total_ns\":%llu,\"ns_per_op\":%.2f}\n", name, count * 2, (unsigned long long)total_ns, double(total_ns) / (count * 2));
+		fflush(g_out);
+	};
+	transitions("prerender.transition.rendered", false);
+	transitions("prerender.transition.prerendered", true);
+	// A script transitioning straight to a scene that was never previewed, and a preview renamed after it was picked, must both still be announced correctly.
+	stub_set_current_scene(obs_scene_get_source(scenes[0]));
+	stub_set_preview_scene(obs_scene_get_source(scenes[1]));
+	stub_emit_frontend_event(OBS_FRONTEND_EVENT_PREVIEW_SCENE_CHANGED);
+	stub_set_current_scene(obs_scene_get_source(scenes[2]));
+	announce(OBS_FRONTEND_EVENT_SCENE_CHANGED);
+	bool script_correct = replace_obs_variables(message, nullptr) == stub_last_utterance();
+	stub_set_current_scene(obs_scene_get_source(scenes[0]));
+	stub_emit_frontend_event(OBS_FRONTEND_EVENT_PREVIEW_SCENE_CHANGED);
+	obs_source_set_name(obs_scene_get_source(scenes[1]), "Gameplay Renamed");
+	stub_set_current_scene(obs_scene_get_source(scenes[1]));
+	announce(OBS_FRONTEND_EVENT_SCENE_CHANGED);
+	bool rename_correct = replace_obs_variables(message, nullptr) == stub_last_utterance();
+	// Likewise a source in the preview muted after it was picked.
+	obs_source_t* audio = obs_source_create("accessibility_event_audio", "Desktop Audio", nullptr, nullptr);
+	obs_scene_add(scenes[1], audio);
+	stub_set_current_scene(obs_scene_get_source(scenes[0]));
+	stub_emit_frontend_event(OBS_FRONTEND_EVENT_PREVIEW_SCENE_CHANGED);
+	obs_source_set_muted(audio, true);
+	stub_set_current_scene(obs_scene_get_source(scenes[1]));
+	announce(OBS_FRONTEND_EVENT_SCENE_CHANGED);
+	string muted_expected = replace_obs_variables(message, nullptr);
+	bool mute_correct = muted_expected == stub_last_utterance() && muted_expected.find(_t("scene_item.muted")) != string::npos;
+	fprintf(g_out, "{\"name\":\"prerender.check\",\"transitions_correct\":%s,\"script_correct\":%s,\"rename_correct\":%s,\"mute_correct\":%s}\n", correct? "true" : "false", script_correct? "true" : "false", rename_correct? "true" : "false", mute_correct? "true" : "false");
+	fflush(g_out);
+	bool passed = correct && script_correct && rename_correct && mute_correct;
+	if (!passed) fprintf(stderr, "prerendered announcement mismatch\n");
+	stub_set_current_scene(nullptr);
+	stub_set_preview_scene(nullptr);
+	stub_emit_frontend_event(OBS_FRONTEND_EVENT_STUDIO_MODE_DISABLED);
+	set_event_message("scene_changed", nullptr);
+	set_event_message("transition_stopped", nullptr);
+	refresh_event_cache();
+	for (obs_source_t* source : sources) obs_source_release(source);
+	obs_source_release(audio);
+	for (obs_scene_t* scene : scenes) obs_scene_release(scene);
+	return passed;
+}
+
+void set_event_rules(const char* id, const vector<string>& rules) {
+	OBSDataAutoRelease config = get_config();
+	OBSDataAutoRelease events = obs_data_get_obj(config, "events");
+	if (!events) {
+		events = obs_data_create();
+		obs_data_set_obj(config, "events", events);
+	}
+	OBSDataAutoRelease event = obs_data_get_obj(events, id);
+	if (!event) {
+		event = obs_data_create();
+		obs_data_set_obj(events, id, event);
+	}
+	OBSDataArrayAutoRelease list = obs_data_array_create();
+	for (const string& rule : rules) {
+		OBSDataAutoRelease item = obs_data_create();
+		obs_data_set_string(item, "value", rule.c_str());
+		obs_data_array_push_back(list, item);
+	}
+	obs_data_set_array(event, "rules", list);
+	refresh_event_cache();
+}
+
+bool bench_rules() {
+	// A typical rule set evaluated against calldata that matches its first rule, its last one and none at all, then the same rules deciding what real signals announce.
+	vector<string> rules = {"source.typeid=scene => earcon", "source.name=Helper* => drop", "source.name=*[hidden]* & filter.name!=Keep => drop", "source.name=Camera => {source.name} is live"};
+	event_rule_program* program = compile_event_rules(rules);
+	obs_source_t* helper = stub_create_source("bench_input", "Helper 3"), *camera = stub_create_source("bench_input", "Camera"), *other = stub_create_source("bench_input", "Desktop Audio");
+	calldata_t cd;
+	calldata_init(&cd);
+	const event_rule* rule = nullptr;
+	bool passed = true;
+	auto match = [&](const char* name, obs_source_t* source) {
+		calldata_set_ptr(&cd, "source", source);
+		g_allocations = 0;
+		g_count_allocations = true;
+		run(name, 1000000, [&] { rule = match_event_rules(program, &cd); });
+		g_count_allocations = false;
+		if (g_allocations) {
+			fprintf(stderr, "%s allocated\n", name);
+			passed = false;
+		}
+	};
+	match("rules.match.second", helper);
+	if (wants("rules.match.second") && (!rule || rule->action != EVENT_RULE_DROP)) {
+		fprintf(stderr, "rules matched the wrong rule\n");
+		passed = false;
+	}
+	match("rules.match.last", camera);
+	if (wants("rules.match.last") && (!rule || rule->action != EVENT_RULE_SPEAK)) {
+		fprintf(stderr, "rules matched the wrong rule\n");
+		passed = false;
+	}
+	match("rules.match.none", other);
+	if (wants("rules.match.none") && rule) {
+		fprintf(stderr, "rules matched the wrong rule\n");
+		passed = false;
+	}
+	calldata_free(&cd);
+	free_event_rules(program);
+	if (wants("rules.signals")) {
+		// Helper is dropped before it reaches the queue, Desktop Audio matches no rule and gets the default message, and Camera speaks its rule's message.
+		set_event_rules("source_show", rules);
+		dispatch_stats before = get_dispatch_stats();
+		uint64_t utterances = stub_utterance_count();
+		for (obs_source_t* source : {helper, other, camera}) {
+			calldata_t show;
+			calldata_init(&show);
+			calldata_set_ptr(&show, "source", source);
+			stub_emit_signal("source_show", &show);
+			calldata_free(&show);
+		}
+		for (int i = 0; i < 1000 && stub_utterance_count() - utterances < 2; i++) this_thread::sleep_for(chrono::milliseconds(1));
+		dispatch_stats after = get_dispatch_stats();
+		bool spoken = strcmp(stub_last_utterance(), "Camera is live") == 0;
+		fprintf(g_out, "{\"name\":\"rules.signals\",\"filtered\":%llu,\"dispatched\":%llu,\"announcements\":%llu,\"spoken\":%s}\n", (unsigned long long)(after.filtered - before.filtered), (unsigned long long)(after.dispatched - before.dispatched), (unsigned long long)(stub_utterance_count() - utterances), spoken? "true" : "false");
+		fflush(g_out);
+		set_event_rules("source_show", {});
+	}
+	obs_source_release(helper);
+	obs_source_release(camera);
+	obs_source_release(other);
+	return passed;
+}
+
+bool bench_history() {
+	// Recording into the ring, reading it back while another thread records as fast as it can, and the whole ring formatted for export.
+	event_type* event = get_event_type("source_show");
+	string text = "Camera shown";
+	run("history.record", 1000000, [&] { record_history(event, text); });
+	history_entry entry;
+	bool intact = true;
+	run("history.read", 1000000, [&] { get_history_entry(get_history_end() - 1, entry); });
+	if (wants("history.concurrent")) {
+		// Every message carries its own index, so a torn read shows up as text that doesn't match the entry it came from.
+		atomic<bool> writing = true;
+		uint64_t base = get_history_end();
+		thread writer([&] {
+			char message[64];
+			for (uint64_t i = 0; i < 2000000; i++) {
+				snprintf(message, sizeof(message), "message %llu", (unsigned long long)(base + i));
+				record_history(event, message);
+			}
+			writing = false;
+		});
+		uint64_t reads = 0, missed = 0, torn = 0;
+		char expected[64];
+		while (writing) {
+			uint64_t index = get_history_end() - 1 - reads % 16;
+			if (!get_history_entry(index, entry)) missed++;
+			else {
+				snprintf(expected, sizeof(expected), "message %llu", (unsigned long long)entry.index);
+				if (entry.index >= base && entry.text != expected) torn++;
+			}
+			reads++;
+		}
+		writer.join();
+		fprintf(g_out, "{\"name\":\"history.concurrent\",\"reads\":%llu,\"missed\":%llu,\"torn\":%llu}\n", (unsigned long long)reads, (unsigned long long)missed, (unsigned long long)torn);
+		fflush(g_out);
+		intact = !torn;
+		if (!intact) fprintf(stderr, "history returned torn entries\n");
+	}
+	run("history.format", 1000, [] { format_history(); });
+	if (!wants("history.announced")) return intact;
+	// A real announcement lands in the ring as it is spoken.
+	uint64_t utterances = stub_utterance_count();
+	bool pressed = stub_press_hotkey("announce_system_stats");
+	for (int i = 0; i < 1000 && stub_utterance_count() - utterances < 1; i++) this_thread::sleep_for(chrono::milliseconds(1));
+	bool recorded = get_history_entry(get_history_end() - 1, entry) && entry.event_id == "system_stats" && entry.text == stub_last_utterance();
+	fprintf(g_out, "{\"name\":\"history.announced\",\"pressed\":%s,\"recorded\":%s}\n", pressed? "true" : "false", recorded? "true" : "false");
+	fflush(g_out);
+	return intact;
+}
+
+#ifndef _WIN32
+// Minimal JSON subscriber for bench_stream(), counting what it is sent and remembering the last event.
+struct stream_subscriber {
+	int fd = -1;
+	atomic<uint64_t> events = 0, dropped = 0, bytes = 0;
+	mutex lock;
+	string last;
+	thread reader;
+	bool connect_to(const string& path, bool read) {
+		sockaddr_un address = {};
+		address.sun_family = AF_UNIX;
+		memcpy(address.sun_path, path.c_str(), min(path.size() + 1, sizeof(address.sun_path) - 1));
+		fd = socket(AF_UNIX, SOCK_STREAM, 0);
+		if (fd < 0 || connect(fd, (sockaddr*)&address, sizeof(address)) != 0) return false;
+		if (!read) {
+			// A client that asks for binary records and then never reads any, with as little socket buffer as it can get.
+			int size = 4096;
+			setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &size, sizeof(size));
+			return send(fd, "binary\n", 7, 0) == 7;
+		}
+		reader = thread([this] {
+			string buffer;
+			char chunk[65536];
+			ssize_t received;
+			while ((received = recv(fd, chunk, sizeof(chunk), 0)) > 0) {
+				bytes += received;
+				buffer.append(chunk, received);
+				size_t start = 0, end;
+				while ((end = buffer.find('\n', start)) != string::npos) {
+					string_view line(buffer.data() + start, end - start);
+					const char* prefix = "{\"type\":\"dropped\",\"count\":";
+					if (line.starts_with(prefix)) dropped += strtoull(line.data() + strlen(prefix), nullptr, 10);
+					else {
+						events++;
+						lock_guard<mutex> guard(lock);
+						last = line;
+					}
+					start = end + 1;
+				}
+				buffer.erase(0, start);
+			}
+		});
+		return true;
+	}
+	void disconnect() {
+		if (fd >= 0) shutdown(fd, SHUT_RDWR);
+		if (reader.joinable()) reader.join();
+		if (fd >= 0) close(fd);
+		fd = -1;
+	}
+};
+#endif
+bool bench_api() {
+	// Every case goes through proc_handler_call the way obspython and obslua do, with speech on the loopback backend.
+	if (!wants("api")) return true;
+	proc_handler_t* procs = obs_get_proc_handler();
+	auto drain = [] {
+		for (int i = 0; i < 5000 && get_dispatch_stats().pending; i++) this_thread::sleep_for(chrono::milliseconds(1));
+	};
+	calldata_t cd;
+	calldata_init(&cd);
+	calldata_set_string(&cd, "id", "bench_chat");
+	calldata_set_string(&cd, "name", "Chat message");
+	calldata_set_string(&cd, "message", "Chat: {message}");
+	proc_handler_call(procs, "accessibility_register_event", &cd);
+	bool registered = calldata_bool(&cd, "registered");
+	uint64_t utterances = stub_utterance_count();
+	calldata_set_string(&cd, "message", "hello");
+	calldata_set_string(&cd, "event", "bench_chat");
+	proc_handler_call(procs, "accessibility_announce", &cd);
+	bool queued = calldata_bool(&cd, "queued");
+	for (int i = 0; i < 1000 && stub_utterance_count() == utterances; i++) this_thread::sleep_for(chrono::milliseconds(1));
+	bool spoken = stub_utterance_count() > utterances && string(stub_last_utterance()) == "Chat: hello";
+	proc_handler_call(procs, "accessibility_announce", &cd);
+	bool repeat_dropped = !calldata_bool(&cd, "queued");
+	fprintf(g_out, "{\"name\":\"api.custom_event\",\"registered\":%s,\"queued\":%s,\"spoken\":%s,\"repeat_dropped\":%s}\n", registered? "true" : "false", queued? "true" : "false", spoken? "true" : "false", repeat_dropped? "true" : "false");
+	fflush(g_out);
+	bool announced = registered && spoken && repeat_dropped;
+	if (!announced) fprintf(stderr, "announcing through the proc handler failed\n");
+	// A hundred announcements as separate calls and then as one batch, each sized to fit the dispatch queue.
+	vector<string> messages;
+	string batch;
+	for (int i = 0; i < 100; i++) {
+		messages.push_back("Chat line " + to_string(i));
+		batch += "Batched line " + to_string(i) + "\n";
+	}
+	drain();
+	calldata_set_string(&cd, "event", "");
+	run("api.announce.100_calls", 1, [&] {
+		for (const string& message : messages) {
+			calldata_set_string(&cd, "message", message.c_str());
+			proc_handler_call(procs, "accessibility_announce", &cd);
+		}
+	}, messages.size(), false);
+	drain();
+	calldata_set_string(&cd, "messages", batch.c_str());
+	long long batched = 0;
+	run("api.announce_batch.100", 1, [&] {
+		proc_handler_call(procs, "accessibility_announce_batch", &cd);
+		batched = calldata_int(&cd, "queued");
+	}, messages.size(), false);
+	drain();
+	proc_handler_call(procs, "accessibility_stats", &cd);
+	fprintf(g_out, "{\"name\":\"api.stats\",\"batched\":%lld,\"dispatched\":%lld,\"dropped\":%lld,\"pending\":%lld,\"repeats\":%lld}\n", batched, calldata_int(&cd, "dispatched"), calldata_int(&cd, "dropped"), calldata_int(&cd, "pending"), calldata_int(&cd, "repeats"));
+	fflush(g_out);
+	calldata_free(&cd);
+	return announced;
+}
+
+void set_event_timing(const char* id, const char* timing) {
+	OBSDataAutoRelease config = get_config();
+	OBSDataAutoRelease events = obs_data_get_obj(config, "events");
+	if (!events) {
+		events = obs_data_create();
+		obs_data_set_obj(config, "events", events);
+	}
+	OBSDataAutoRelease event = obs_data_get_obj(events, id);
+	if (!event) {
+		event = obs_data_create();
+		obs_data_set_obj(events, id, event);
+	}
+	obs_data_set_string(event, "timing", timing);
+}
+
+bool bench_timing() {
+	// Time from a signal to its message reaching the speech backend under each timing. source_show.wav plays for about 206 ms from the 20 ms latency target, so speech set to follow it should wait roughly a quarter second while speech together with it goes out at once.
+	if (!wants("timing")) return true;
+	obs_source_t* src = stub_create_source("bench_input", "Camera");
+	calldata_t cd;
+	calldata_init(&cd);
+	calldata_set_ptr(&cd, "source", src);
+	set_event_message("source_show", "{source.name} shown");
+	refresh_event_cache();
+	auto spoken_after = [&](const char* timing) {
+		set_event_timing("source_show", timing);
+		uint64_t utterances = stub_utterance_count();
+		uint64_t start = os_gettime_ns();
+		stub_emit_signal("source_show", &cd);
+		while (stub_utterance_count() == utterances && os_gettime_ns() - start < 2000000000) this_thread::sleep_for(chrono::microseconds(100));
+		return (os_gettime_ns() - start) / 1000000.0;
+	};
+	double together_ms = spoken_after("together");
+	double after_ms = spoken_after("after_earcon");
+	// Two events 20 ms apart while speech is quiet, the second only sounds its earcon since the first is still being spoken.
+	set_event_timing("source_show", "earcon_when_busy");
+	this_thread::sleep_for(chrono::milliseconds(SPEECH_MS_PER_CHARACTER * 20));
+	uint64_t utterances = stub_utterance_count();
+	stub_emit_signal("source_show", &cd);
+	this_thread::sleep_for(chrono::milliseconds(20));
+	stub_emit_signal("source_show", &cd);
+	this_thread::sleep_for(chrono::milliseconds(100));
+	uint64_t busy_spoken = stub_utterance_count() - utterances;
+	set_event_timing("source_show", "together");
+	set_event_message("source_show", nullptr);
+	refresh_event_cache();
+	fprintf(g_out, "{\"name\":\"timing\",\"together_ms\":%.2f,\"after_earcon_ms\":%.2f,\"earcon_when_busy_spoken\":%llu}\n", together_ms, after_ms, (unsigned long long)busy_spoken);
+	fflush(g_out);
+	bool followed = together_ms <= 100 && after_ms >= 200 && after_ms <= 400 && busy_spoken == 1;
+	if (!followed) fprintf(stderr, "speech did not follow its timing\n");
+	calldata_free(&cd);
+	obs_source_release(src);
+	return followed;
+}
+
+bool bench_stream() {
+	// Publishing to one subscriber that keeps up and one that never reads, which must cost the publisher nothing beyond dropping its records.
+#ifndef _WIN32
+	if (!wants("stream")) return true;
+	filesystem::path runtime_dir = filesystem::temp_directory_path() / "obs-accessibility-bench-run";
+	filesystem::create_directories(runtime_dir);
+	setenv("XDG_RUNTIME_DIR", runtime_dir.string().c_str(), 1);
+	set_event_stream(true);
+	stream_subscriber fast, slow;
+	bool connected = fast.connect_to(get_event_stream_path(), true) && slow.connect_to(get_event_stream_path(), false);
+	for (int i = 0; i < 1000 && get_event_stream_stats().clients < 2; i++) this_thread::sleep_for(chrono::milliseconds(1));
+	event_type* event = get_event_type("source_show");
+	obs_source_t* src = stub_create_source("bench_input", "Camera");
+	event_stream_stats before = get_event_stream_stats();
+	run("stream.publish.2_clients", 200000, [&] { publish_event(event, "Camera shown", src); });
+	// Whatever the fast subscriber missed is reported ahead of the next record it gets, so one more event once it has caught up settles the count.
+	for (uint64_t seen = 0; seen != fast.bytes; this_thread::sleep_for(chrono::milliseconds(20))) seen = fast.bytes;
+	publish_event(event, "final", src);
+	event_stream_stats after = get_event_stream_stats();
+	uint64_t published = after.published - before.published;
+	for (int i = 0; i < 1000 && fast.events + fast.dropped < published; i++) this_thread::sleep_for(chrono::milliseconds(1));
+	bool accounted = fast.events + fast.dropped == published;
+	fprintf(g_out, "{\"name\":\"stream.clients\",\"connected\":%s,\"published\":%llu,\"fast_received\":%llu,\"fast_dropped\":%llu,\"slow_dropped\":%llu,\"accounted\":%s}\n", connected? "true" : "false", (unsigned long long)published, (unsigned long long)fast.events.load(), (unsigned long long)fast.dropped.load(), (unsigned long long)(after.dropped - before.dropped - fast.dropped), accounted? "true" : "false");
+	fflush(g_out);
+	if (!accounted) fprintf(stderr, "event stream lost records without reporting them\n");
+	// A real announcement reaches subscribers with the message that was spoken.
+	uint64_t utterances = stub_utterance_count(), events = fast.events;
+	bool pressed = stub_press_hotkey("announce_system_stats");
+	for (int i = 0; i < 1000 && (stub_utterance_count() == utterances || fast.events == events); i++) this_thread::sleep_for(chrono::milliseconds(1));
+	string last;
+	{
+		lock_guard<mutex> guard(fast.lock);
+		last = fast.last;
+	}
+	bool streamed = last.find("\"event\":\"system_stats\"") != string::npos && last.find(string("\"message\":\"") + stub_last_utterance() + "\"") != string::npos;
+	fprintf(g_out, "{\"name\":\"stream.announced\",\"pressed\":%s,\"streamed\":%s}\n", pressed? "true" : "false", streamed? "true" : "false");
+	fflush(g_out);
+	fast.disconnect();
+	slow.disconnect();
+	set_event_stream(false);
+	obs_source_release(src);
+	filesystem::remove_all(runtime_dir);
+	return accounted;
+#else
+	return true;
+#endif
+}
+
+void bench_storms() {
+	// Synthetic signal storms delivered through the real global signal callback registered by init_events.
+	obs_source_t* src = stub_create_source("bench_input", "Camera");
+	calldata_t cd;
+	calldata_init(&cd);
+	calldata_set_ptr(&cd, "source", src);
+	for (const char* signal : {"source_create", "source_show", "source_volume", "hotkey_register"}) {
+		string name = string("storm.") + signal + ".10k";
+		run(name.c_str(), 1, [&] {
+			for (int i = 0; i < 10000; i++) stub_emit_signal(signal, &cd);
+		}, 10000);
+	}
+	run("storm.frontend.scene_changed.10k", 1, [] {
+		for (int i = 0; i < 10000; i++) stub_emit_frontend_event(OBS_FRONTEND_EVENT_SCENE_CHANGED);
+	}, 10000);
+	calldata_free(&cd);
+	obs_source_release(src);
+}
+
+// Lines in the shape of a real OBS log from startup through an hour of streaming, used when no --log file is given. Most lines mention no failure at all, as in a real log.
+const char* g_sample_log[] = {
+	"CPU Name: AMD Ryzen 7 5800X 8-Core Processor",
+	"Physical Memory: 32691MB Total, 21037MB Free",
+	"OBS 31.0.0 (linux)",
+	"---------------------------------",
+	"Loading module: obs-ffmpeg.so",
+	"[obs-browser]: Version 2.24.1",
+	"audio settings reset:\n\tsamples per sec: 48000\n\tspeakers:        2\n\tmax buffering:   960 milliseconds\n\tbuffering type:  dynamically increasing",
+	"video settings reset:\n\tbase resolution:   1920x1080\n\toutput resolution: 1280x720\n\tdownscale filter:  Bicubic\n\tfps:               30/1\n\tformat:            NV12",
+	"Switched to scene 'Starting Soon'",
+	"adding 21 milliseconds of audio buffering, total audio buffering is now 42 milliseconds (source: Desktop Audio)",
+	"[Media Source 'Intro Video']: MP: Failed to open media: '/home/user/Videos/intro.mp4'",
+	"User added source 'Camera' (v4l2_input) to scene 'Main'",
+	"[x264 encoder: 'simple_video_stream'] preset: veryfast",
+	"[x264 encoder: 'simple_video_stream'] settings:\n\trate_control: CBR\n\tbitrate:      6000\n\tbuffer size:  6000\n\tcrf:          23",
+	"[rtmp stream: 'simple_stream'] Connecting to RTMP URL rtmp://live.twitch.tv/app...",
+	"[rtmp stream: 'simple_stream'] Interface: Intel(R) Ethernet Connection (ethernet, 1000 mbps)",
+	"[rtmp stream: 'simple_stream'] Connection to rtmp://live.twitch.tv/app successful",
+	"==== Streaming Start ===============================================",
+	"Source Camera audio is lagging (over by 121.33 ms) at max audio buffering. Restarting source audio.",
+	"[rtmp stream: 'simple_stream'] Disconnected from rtmp://live.twitch.tv/app",
+	"Output 'simple_stream': Reconnecting in 10.00 seconds..",
+	"Output 'simple_stream': Reconnect successful",
+	"User switched to scene 'Main'",
+	"Source ID 'old_plugin_source' not found",
+	"[image_source: 'Logo'] failed to load texture '/home/user/Pictures/logo.png'",
+	"Output 'simple_stream': stopping",
+	"Output 'simple_stream': Total frames output: 107997",
+	"Output 'simple_stream': Total drawn frames: 108012 (108017 attempted)",
+	"Output 'simple_stream': Number of lagged frames due to rendering lag/stalls: 5 (0.0%)",
+	"==== Streaming Stop ================================================",
+	"Video stopped, number of skipped frames due to encoding lag: 12/108017 (0.0%)",
+};
+bool bench_tones() {
+	// Value tones are synthesized inside the mixer block, so an idle bank must cost next to nothing and a full one a small fraction of the 10 ms block, and starting one must never allocate.
+	if (!wants("tones")) return true;
+	unique_ptr<tone_bank> bank(new tone_bank());
+	tone_spec pitch;
+	parse_tone_spec("pitch {tbar} 0 1023", pitch);
+	float buffer[EVENT_SOURCE_BLOCK_FRAMES * 2];
+	uint64_t block_frame = 0;
+	run("tones.render.idle", 1000000, [&] { render_tones(&*bank, buffer, EVENT_SOURCE_BLOCK_FRAMES, block_frame += EVENT_SOURCE_BLOCK_FRAMES); });
+	// Sixteen tones at once last six blocks.
+	run("tones.render.16_voices", 2000, [&] {
+		for (int i = 0; i < TONE_VOICES; i++) trigger_tone(&*bank, pitch, i / float(TONE_VOICES), 0);
+		for (int i = 0; i < 6; i++) render_tones(&*bank, buffer, EVENT_SOURCE_BLOCK_FRAMES, block_frame += EVENT_SOURCE_BLOCK_FRAMES);
+	}, 6);
+	g_allocations = 0;
+	run("tones.trigger", 1000000, [&] {
+		g_count_allocations = true;
+		trigger_tone(&*bank, pitch, 0.5f, 0);
+		g_count_allocations = false;
+		render_tones(&*bank, buffer, 0, block_frame); // Drains the ring without mixing anything.
+	});
+	uint64_t allocations = g_allocations;
+	// A tone asked to start 100 frames into a block stays silent until then, and the middle of the pitch range lands on 622 Hz.
+	bank.reset(new tone_bank());
+	vector<float> out(TONE_MS * 48 * 2 + EVENT_SOURCE_BLOCK_FRAMES * 2, 0.0f);
+	trigger_tone(&*bank, pitch, 0.5f, 100);
+	for (size_t frame = 0; frame < out.size() / 2; frame += EVENT_SOURCE_BLOCK_FRAMES) render_tones(&*bank, &out[frame * 2], EVENT_SOURCE_BLOCK_FRAMES, frame);
+	bool silent_before = all_of(out.begin(), out.begin() + 200, [](float sample) { return sample == 0.0f; });
+	int crossings = 0;
+	for (size_t i = 202; i < out.size(); i += 2) crossings += (out[i - 2] < 0.0f) != (out[i] < 0.0f) && out[i] != 0.0f;
+	float peak = 0.0f;
+	for (float sample : out) peak = max(peak, fabsf(sample));
+	fprintf(g_out, "{\"name\":\"tones.shape\",\"silent_before_start\":%s,\"frequency_hz\":%.0f,\"peak\":%.3f,\"trigger_allocations\":%llu}\n", silent_before? "true" : "false", crossings / 2.0 * 1000.0 / TONE_MS, peak, (unsigned long long)allocations);
+	fflush(g_out);
+	// The default tone for the transition bar reaches the live mixer through the dispatch thread.
+	event_source_data* d = get_audio_event_source();
+	uint32_t before = d->tones.queue_tail;
+	stub_emit_frontend_event(OBS_FRONTEND_EVENT_TBAR_VALUE_CHANGED);
+	for (int i = 0; i < 1000 && d->tones.queue_tail == before; i++) this_thread::sleep_for(chrono::milliseconds(1));
+	fprintf(g_out, "{\"name\":\"tones.tbar\",\"triggered\":%s}\n", d->tones.queue_tail != before? "true" : "false");
+	fflush(g_out);
+	return allocations == 0;
+}
+
+bool bench_logs() {
+	// The log handler runs on every thread that logs, so a line that matches nothing must cost little more than formatting it, and no line may allocate.
+	if (!wants("logs")) return true;
+	vector<string> lines;
+	if (g_log) {
+		ifstream file(g_log);
+		for (string line; getline(file, line);) lines.push_back(line);
+	}
+	if (lines.empty()) {
+		for (int repeat = 0; repeat < 2000; repeat++) {
+			for (const char* line : g_sample_log) lines.push_back(line);
+		}
+	}
+	// A real announcement of a built in pattern and of a user pattern, before the replay starts holding them back for ten seconds.
+	uint64_t utterances = stub_utterance_count();
+	blog(LOG_WARNING, "Output '%s': Reconnecting in %.02f seconds..", "simple_stream", 2.0);
+	for (int i = 0; i < 1000 && stub_utterance_count() == utterances; i++) this_thread::sleep_for(chrono::milliseconds(1));
+	bool reconnect = stub_utterance_count() > utterances && string(stub_last_utterance()) == "Output reconnecting";
+	set_log_patterns({"DROPPED FRAMES"});
+	utterances = stub_utterance_count();
+	blog(LOG_INFO, "%d dropped frames on output '%s'", 42, "simple_stream");
+	for (int i = 0; i < 1000 && stub_utterance_count() == utterances; i++) this_thread::sleep_for(chrono::milliseconds(1));
+	bool user_pattern = stub_utterance_count() > utterances && string(stub_last_utterance()) == "42 dropped frames on output 'simple_stream'";
+	fprintf(g_out, "{\"name\":\"logs.announced\",\"reconnect\":%s,\"user_pattern\":%s}\n", reconnect? "true" : "false", user_pattern? "true" : "false");
+	fflush(g_out);
+	run("logs.unmatched", 1000000, [] { blog(LOG_INFO, "[rtmp stream: '%s'] Interface: %s (ethernet, %d mbps)", "simple_stream", "Intel(R) Ethernet Connection", 1000); });
+	run("logs.debug", 1000000, [] { blog(LOG_DEBUG, "[rtmp stream: '%s'] Interface: %s (ethernet, %d mbps)", "simple_stream", "Intel(R) Ethernet Connection", 1000); });
+	const string& longest = *max_element(lines.begin(), lines.end(), [](const string& a, const string& b) { return a.size() < b.size(); });
+	run("logs.match_only.longest", 1000000, [&] { match_log_line(longest.data(), longest.size()); });
+	uint64_t matched = 0;
+	for (const string& line : lines) matched += match_log_line(line.data(), line.size()) >= 0;
+	g_allocations = 0;
+	string name = "logs.replay." + to_string(lines.size());
+	run(name.c_str(), 1, [&] {
+		g_count_allocations = true;
+		for (const string& line : lines) blog(LOG_INFO, "%s", line.c_str());
+		g_count_allocations = false;
+	}, lines.size(), false);
+	fprintf(g_out, "{\"name\":\"logs.replay.allocations\",\"lines\":%zu,\"matched\":%llu,\"allocations\":%llu}\n", lines.size(), (unsigned long long)matched, (unsigned long long)g_allocations);
+	fflush(g_out);
+	set_log_patterns({});
+	return g_allocations == 0;
+}
+
+bool bench_hot_path() {
+	// Replays a burst of signals and counts every heap allocation the emitting thread makes between signal receipt and enqueue. Anything above zero fails the run.
+	if (!wants("hot_path")) return true;
+	obs_source_t* src = stub_create_source("bench_input", "Camera");
+	calldata_t cd;
+	calldata_init(&cd);
+	calldata_set_ptr(&cd, "source", src);
+	calldata_set_bool(&cd, "muted", true);
+	const char* signals[] = {"source_show", "source_hide", "source_volume", "source_rename", "source_create", "unknown"};
+	dispatch_stats before = get_dispatch_stats();
+	g_allocations = 0;
+	g_count_allocations = true;
+	auto start = chrono::steady_clock::now();
+	for (int i = 0; i < 10000; i++) stub_emit_signal(signals[i % size(signals)], &cd);
+	uint64_t total_ns = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+	g_count_allocations = false;
+	dispatch_stats after = get_dispatch_stats();
+	fprintf(g_out, "{\"name\":\"hot_path.allocations\",\"events\":10000,\"allocations\":%llu,\"dispatched\":%llu,\"dropped\":%llu,\"ns_per_op\":%.2f}\n", (unsigned long long)g_allocations, (unsigned long long)(after.dispatched - before.dispatched), (unsigned long long)(after.dropped - before.dropped), total_ns / 10000.0);
+	fflush(g_out);
+	calldata_free(&cd);
+	obs_source_release(src);
+	return g_allocations == 0;
+}
+
+int main(int argc, char** argv) {
+	for (int i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "--out") && i + 1 < argc) g_out = fopen(argv[++i], "w");
+		else if (!strcmp(argv[i], "--filter") && i + 1 < argc) g_filter = argv[++i];
+		else if (!strcmp(argv[i], "--wav") && i + 1 < argc) g_wav = argv[++i];
+		else if (!strcmp(argv[i], "--log") && i + 1 < argc) g_log = argv[++i];
+	}
+	if (!g_out) {
+		perror("--out");
+		return 1;
+	}
+	filesystem::path config_dir = filesystem::temp_directory_path() / "obs-accessibility-bench";
+	stub_set_paths(BENCH_DATA_DIR, config_dir.string().c_str());
+	// Mirrors obs_module_load without init_interface, which needs Qt, then waits for the background startup task the way OBS_FRONTEND_EVENT_FINISHED_LOADING does.
+	auto start = chrono::steady_clock::now();
+	OBSDataAutoRelease settings = load_config();
+	if (!init_audio(settings)) {
+		fprintf(stderr, "init_audio failed\n");
+		return 1;
+	}
+	init_events();
+	uint64_t load_ns = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+	stub_emit_frontend_event(OBS_FRONTEND_EVENT_FINISHED_LOADING);
+	uint64_t ready_ns = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+	if (wants("startup")) fprintf(g_out, "{\"name\":\"startup\",\"module_load_ns\":%llu,\"ready_ns\":%llu}\n", (unsigned long long)load_ns, (unsigned long long)ready_ns);
+	// A failed behavior check does not stop the later cases, it only fails the exit code.
+	bool behaved = true;
+	bench_event_lookup();
+	bench_templates();
+	bench_properties();
+	behaved = bench_speech() && behaved;
+	bench_play();
+	behaved = bench_direct_output() && behaved;
+	bench_mix();
+	behaved = bench_offline_render() && behaved;
+	behaved = bench_earcon_policy() && behaved;
+	bench_storms();
+	behaved = bench_destroyed_source() && behaved;
+	bench_load_shedding();
+	behaved = bench_stats() && behaved;
+	behaved = bench_levels() && behaved;
+	behaved = bench_video() && behaved;
+	behaved = bench_scenes() && behaved;
+	behaved = bench_prerender() && behaved;
+	behaved = bench_rules() && behaved;
+	behaved = bench_history() && behaved;
+	behaved = bench_stream() && behaved;
+	behaved = bench_api() && behaved;
+	behaved = bench_timing() && behaved;
+	bool tones_ok = bench_tones();
+	bool logs_ok = bench_logs();
+	bool hot_path_ok = bench_hot_path();
+	run("shutdown.exit_event", 1, [] { stub_emit_frontend_event(OBS_FRONTEND_EVENT_EXIT); }, 1, false);
+	shutdown_events();
+	shutdown_speech();
+	if (g_out != stdout) fclose(g_out);
+	if (!hot_path_ok) fprintf(stderr, "hot path allocated\n");
+	if (!logs_ok) fprintf(stderr, "log handler allocated\n");
+	if (!tones_ok) fprintf(stderr, "tone trigger allocated\n");
+	return behaved && hot_path_ok && logs_ok && tones_ok? 0 : 1;
+}
@@ -0,0 +1,128 @@
+/*
+ OBS Accessibility
+ Copyright (C) 2025 Sam Tupy Productions <webmaster@samtupy.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along
+ with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+// Stand-in subscriber for the event stream, prints every record it receives as one line of JSON. Run with --binary to request length prefixed records, which are decoded back into the same lines, and --delay to read slowly enough to watch records being dropped.
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace std;
+
+static string default_path() {
+	// Same rule as get_event_stream_path() in the plugin.
+	const char* runtime_dir = getenv("XDG_RUNTIME_DIR");
+	if (runtime_dir && *runtime_dir) return string(runtime_dir) + "/obs-accessibility.sock";
+	return "/tmp/obs-accessibility-" + to_string(getuid()) + ".sock";
+}
+static uint64_t read_integer(const string& record, size_t& offset, int bytes) {
+	uint64_t value = 0;
+	for (int i = 0; i < bytes && offset < record.size(); i++) value |= uint64_t((unsigned char)record[offset++]) << (i * 8);
+	return value;
+}
+static string read_string(const string& record, size_t& offset, int length_bytes) {
+	size_t length = read_integer(record, offset, length_bytes);
+	string value = record.substr(min(offset, record.size()), length);
+	offset += length;
+	return value;
+}
+static string quote(const string& value) {
+	string out = "\"";
+	for (char c : value) {
+		if (c == '"' || c == '\\') out += '\\';
+		if (c == '\n') out += "\\n";
+		else if ((unsigned char)c >= 0x20) out += c;
+	}
+	return out + "\"";
+}
+static void print_binary_record(const string& record) {
+	size_t offset = 1;
+	if (record[0] == 2) {
+		printf("{\"type\":\"dropped\",\"count\":%llu}\n", (unsigned long long)read_integer(record, offset, 8));
+		return;
+	}
+	uint64_t timestamp = read_integer(record, offset, 8);
+	string event = read_string(record, offset, 2), source = read_string(record, offset, 2), source_uuid = read_string(record, offset, 2), message = read_string(record, offset, 4);
+	printf("{\"type\":\"event\",\"event\":%s,\"message\":%s,", quote(event).c_str(), quote(message).c_str());
+	if (!source_uuid.empty()) printf("\"source\":%s,\"source_uuid\":%s,", quote(source).c_str(), quote(source_uuid).c_str());
+	printf("\"timestamp\":%llu}\n", (unsigned long long)timestamp);
+}
+
+int main(int argc, char** argv) {
+	string path = default_path();
+	bool binary = false;
+	int delay_ms = 0;
+	for (int i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "--binary")) binary = true;
+		else if (!strcmp(argv[i], "--delay") && i + 1 < argc) delay_ms = atoi(argv[++i]);
+		else if (argv[i][0] != '-') path = argv[i];
+		else {
+			fprintf(stderr, "usage: %s [--binary] [--delay ms] [socket path]\n", argv[0]);
+			return 1;
+		}
+	}
+	sockaddr_un address = {};
+	address.sun_family = AF_UNIX;
+	if (path.size() >= sizeof(address.sun_path)) {
+		fprintf(stderr, "%s: path too long\n", path.c_str());
+		return 1;
+	}
+	memcpy(address.sun_path, path.c_str(), path.size() + 1);
+	int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (fd < 0 || connect(fd, (sockaddr*)&address, sizeof(address)) != 0) {
+		perror(path.c_str());
+		return 1;
+	}
+	if (binary && send(fd, "binary\n", 7, 0) != 7) {
+		perror("send");
+		return 1;
+	}
+	string buffer;
+	char chunk[4096];
+	ssize_t received;
+	while ((received = recv(fd, chunk, sizeof(chunk), 0)) > 0) {
+		buffer.append(chunk, received);
+		size_t offset = 0;
+		if (!binary) {
+			// JSON records are already lines.
+			size_t end = buffer.rfind('\n');
+			if (end == string::npos) continue;
+			fwrite(buffer.data(), 1, end + 1, stdout);
+			offset = end + 1;
+		} else {
+			while (buffer.size() - offset >= 4) {
+				size_t length_offset = offset;
+				size_t length = read_integer(buffer, length_offset, 4);
+				if (buffer.size() - offset - 4 < length) break;
+				if (length) print_binary_record(buffer.substr(offset + 4, length));
+				offset += 4 + length;
+			}
+		}
+		buffer.erase(0, offset);
+		fflush(stdout);
+		if (delay_ms) this_thread::sleep_for(chrono::milliseconds(delay_ms));
+	}
+	close(fd);
+	return 0;
+}
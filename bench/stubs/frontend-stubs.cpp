@@ -0,0 +1,89 @@
+/*
+ OBS Accessibility
+ Copyright (C) 2025 Sam Tupy Productions <webmaster@samtupy.com>
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along
+ with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+// In-process implementation of the obs-frontend-api subset declared in include/obs-frontend-api.h.
+#include <cstdlib>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include <obs-frontend-api.h>
+#include <obs-stub.h>
+
+using namespace std;
+
+static mutex g_frontend_lock;
+static vector<pair<obs_frontend_event_cb, void*>> g_frontend_callbacks;
+static obs_source_t* g_current_scene = nullptr;
+static obs_source_t* g_preview_scene = nullptr;
+void obs_frontend_add_event_callback(obs_frontend_event_cb callback, void* private_data) {
+	lock_guard<mutex> l(g_frontend_lock);
+	g_frontend_callbacks.emplace_back(callback, private_data);
+}
+void obs_frontend_remove_event_callback(obs_frontend_event_cb callback, void* private_data) {
+	lock_guard<mutex> l(g_frontend_lock);
+	erase(g_frontend_callbacks, make_pair(callback, private_data));
+}
+void stub_emit_frontend_event(obs_frontend_event event) {
+	vector<pair<obs_frontend_event_cb, void*>> callbacks;
+	{
+		lock_guard<mutex> l(g_frontend_lock);
+		callbacks = g_frontend_callbacks;
+	}
+	for (auto& i : callbacks) i.first(event, i.second);
+}
+void obs_frontend_add_tools_menu_item(const char*, obs_frontend_cb, void*) {}
+void* obs_frontend_get_main_window(void) { return nullptr; }
+void stub_set_current_scene(obs_source_t* scene) {
+	lock_guard<mutex> l(g_frontend_lock);
+	obs_source_release(g_current_scene);
+	g_current_scene = obs_source_get_ref(scene);
+}
+obs_source_t* obs_frontend_get_current_scene(void) {
+	lock_guard<mutex> l(g_frontend_lock);
+	return obs_source_get_ref(g_current_scene);
+}
+void stub_set_preview_scene(obs_source_t* scene) {
+	lock_guard<mutex> l(g_frontend_lock);
+	obs_source_release(g_preview_scene);
+	g_preview_scene = obs_source_get_ref(scene);
+}
+obs_source_t* obs_frontend_get_current_preview_scene(void) {
+	lock_guard<mutex> l(g_frontend_lock);
+	return obs_source_get_ref(g_preview_scene);
+}
+bool obs_frontend_preview_program_mode_active(void) {
+	lock_guard<mutex> l(g_frontend_lock);
+	return g_preview_scene != nullptr;
+}
+void obs_frontend_get_scenes(struct obs_frontend_source_list* sources) {
+	vector<obs_source_t*> scenes;
+	obs_enum_scenes([](void* param, obs_source_t* scene) {
+		static_cast<vector<obs_source_t*>*>(param)->push_back(obs_source_get_ref(scene));
+		return true;
+	}, &scenes);
+	sources->sources.array = static_cast<obs_source_t**>(malloc(scenes.size() * sizeof(obs_source_t*)));
+	sources->sources.num = sources->sources.capacity = scenes.size();
+	for (size_t i = 0; i < scenes.size(); i++) sources->sources.array[i] = scenes[i];
+}
+int obs_frontend_get_tbar_position(void) { return 0; }
+void obs_frontend_open_source_properties(obs_source_t*) {}
+bool obs_frontend_streaming_active(void) { return false; }
+bool obs_frontend_recording_active(void) { return false; }
+bool obs_frontend_recording_paused(void) { return false; }
+obs_output_t* obs_frontend_get_streaming_output(void) { return obs_output_get_ref(stub_get_output(true)); }
+obs_output_t* obs_frontend_get_recording_output(void) { return obs_output_get_ref(stub_get_output(false)); }
@@ -0,0 +1,38 @@
+/*
+ OBS Accessibility
+ Copyright (C) 2025 Sam Tupy Productions <webmaster@samtupy.com>
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along
+ with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+// Stand-in for the libobs header of the same name, see obs.h.
+#pragma once
+#include <obs.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// In a real plugin these are generated by OBS_DECLARE_MODULE and OBS_MODULE_USE_DEFAULT_LOCALE, the stub resolves them against the repository's data directory instead.
+#define OBS_DECLARE_MODULE()
+#define OBS_MODULE_USE_DEFAULT_LOCALE(module_name, default_locale)
+obs_module_t* obs_current_module(void);
+const char* obs_module_text(const char* lookup_string);
+bool obs_module_get_string(const char* lookup_string, const char** translated_string);
+char* obs_module_file(const char* file);
+char* obs_module_config_path(const char* file);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,39 @@
+/*
+ OBS Accessibility
+ Copyright (C) 2025 Sam Tupy Productions <webmaster@samtupy.com>
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along
+ with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+// Functions that only exist in the stub environment, used by the benchmark harness to stand in for OBS itself: emitting signals and frontend events, creating plain sources and inspecting what the plugin produced.
+#pragma once
+#include <obs.h>
+#include <obs-frontend-api.h>
+
+void stub_set_paths(const char* data_dir, const char* config_dir); // Where obs_module_file and obs_module_config_path resolve.
+void stub_emit_signal(const char* signal, calldata_t* data); // Emits a signal on the core signal handler.
+void stub_emit_frontend_event(obs_frontend_event event);
+obs_source_t* stub_create_source(const char* id, const char* name); // Creates a plain input source of an unregistered type, release with obs_source_release.
+void stub_set_current_scene(obs_source_t* scene);
+void stub_set_preview_scene(obs_source_t* scene); // Anything but null also turns on studio mode.
+uint64_t stub_audio_frames_output(); // Total frames passed to obs_source_output_audio by all sources.
+uint64_t stub_utterance_count(); // Total successful prism_backend_speak calls.
+const char* stub_last_utterance();
+void stub_capture_audio(obs_source_t* source, const struct audio_data* audio, bool muted); // Hands a block of planar float audio to the source's audio capture callbacks.
+void stub_output_video(struct video_data* frame); // Hands a frame to the raw video callbacks whose frame rate divisor it falls on, converted to nothing, so it must already be in their format.
+size_t stub_raw_video_callback_count();
+bool stub_press_hotkey(const char* name); // Presses and releases a registered hotkey, returns false if there is none by that name.
+void stub_set_load(double cpu_percent, uint32_t frames, uint32_t lagged, uint32_t skipped); // Sets CPU usage and advances the rendered, lagged and skipped frame counters.
+obs_output_t* stub_get_output(bool streaming); // The stand-ins returned by obs_frontend_get_streaming_output and obs_frontend_get_recording_output.
+void stub_set_output(bool streaming, bool active, int total_frames, int dropped_frames, uint64_t total_bytes, float congestion = 0.0f, bool reconnecting = false);
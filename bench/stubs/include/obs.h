@@ -0,0 +1,430 @@
+/*
+ OBS Accessibility
+ Copyright (C) 2025 Sam Tupy Productions <webmaster@samtupy.com>
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along
+ with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+// Minimal stand-in for the parts of libobs the plugin core uses, so that those sources can be compiled and benchmarked headless. Declarations mirror the real libobs signatures; only behavior the plugin relies on is implemented in obs-stubs.cpp.
+#pragma once
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "util/threading.h"
+
+#define UNUSED_PARAMETER(param) (void)param
+#define MODULE_EXPORT
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// util/base.h
+enum {
+	LOG_ERROR = 100,
+	LOG_WARNING = 200,
+	LOG_INFO = 300,
+	LOG_DEBUG = 400
+};
+typedef void (*log_handler_t)(int lvl, const char* msg, va_list args, void* p);
+void blog(int log_level, const char* format, ...);
+void blogva(int log_level, const char* format, va_list args);
+void base_get_log_handler(log_handler_t* handler, void** param);
+void base_set_log_handler(log_handler_t handler, void* param);
+
+// util/bmem.h
+void* bmalloc(size_t size);
+void* bzalloc(size_t size);
+void bfree(void* ptr);
+char* bstrdup(const char* str);
+
+// util/platform.h
+uint64_t os_gettime_ns(void);
+bool os_sleepto_ns(uint64_t time_target);
+void os_sleep_ms(uint32_t duration);
+int os_mkdirs(const char* path);
+int os_mkdir(const char* path);
+int os_unlink(const char* path);
+int os_rename(const char* old_path, const char* new_path);
+bool os_file_exists(const char* path);
+bool os_quick_write_utf8_file_safe(const char* path, const char* str, size_t len, bool marker, const char* temp_ext, const char* backup_ext);
+int64_t os_get_file_size(const char* path);
+struct os_cpu_usage_info;
+typedef struct os_cpu_usage_info os_cpu_usage_info_t;
+os_cpu_usage_info_t* os_cpu_usage_info_start(void);
+double os_cpu_usage_info_query(os_cpu_usage_info_t* info);
+void os_cpu_usage_info_destroy(os_cpu_usage_info_t* info);
+uint64_t os_get_proc_resident_size(void);
+
+// callback/calldata.h
+struct calldata {
+	uint8_t* stack;
+	size_t size;
+	size_t capacity;
+	bool fixed;
+};
+typedef struct calldata calldata_t;
+void calldata_init(calldata_t* data);
+void calldata_init_fixed(calldata_t* data, uint8_t* stack, size_t size);
+void calldata_free(calldata_t* data);
+bool calldata_get_data(const calldata_t* data, const char* name, void* out, size_t size);
+void calldata_set_data(calldata_t* data, const char* name, const void* in, size_t new_size);
+bool calldata_get_string(const calldata_t* data, const char* name, const char** str);
+static inline void calldata_clear(calldata_t* data) {
+	if (data->stack) {
+		data->size = sizeof(size_t);
+		memset(data->stack, 0, sizeof(size_t));
+	}
+}
+static inline bool calldata_get_int(const calldata_t* data, const char* name, long long* val) { return calldata_get_data(data, name, val, sizeof(*val)); }
+static inline bool calldata_get_float(const calldata_t* data, const char* name, double* val) { return calldata_get_data(data, name, val, sizeof(*val)); }
+static inline bool calldata_get_bool(const calldata_t* data, const char* name, bool* val) { return calldata_get_data(data, name, val, sizeof(*val)); }
+static inline bool calldata_get_ptr(const calldata_t* data, const char* name, void* p_ptr) { return calldata_get_data(data, name, p_ptr, sizeof(p_ptr)); }
+static inline void calldata_set_int(calldata_t* data, const char* name, long long val) { calldata_set_data(data, name, &val, sizeof(val)); }
+static inline void calldata_set_float(calldata_t* data, const char* name, double val) { calldata_set_data(data, name, &val, sizeof(val)); }
+static inline void calldata_set_bool(calldata_t* data, const char* name, bool val) { calldata_set_data(data, name, &val, sizeof(val)); }
+static inline void calldata_set_ptr(calldata_t* data, const char* name, void* ptr) { calldata_set_data(data, name, &ptr, sizeof(ptr)); }
+static inline void calldata_set_string(calldata_t* data, const char* name, const char* str) {
+	if (str) calldata_set_data(data, name, str, strlen(str) + 1);
+	else calldata_set_data(data, name, NULL, 0);
+}
+static inline long long calldata_int(const calldata_t* data, const char* name) {
+	long long val = 0;
+	calldata_get_int(data, name, &val);
+	return val;
+}
+static inline double calldata_float(const calldata_t* data, const char* name) {
+	double val = 0.0;
+	calldata_get_float(data, name, &val);
+	return val;
+}
+static inline bool calldata_bool(const calldata_t* data, const char* name) {
+	bool val = false;
+	calldata_get_bool(data, name, &val);
+	return val;
+}
+static inline void* calldata_ptr(const calldata_t* data, const char* name) {
+	void* val = NULL;
+	calldata_get_ptr(data, name, &val);
+	return val;
+}
+static inline const char* calldata_string(const calldata_t* data, const char* name) {
+	const char* val = NULL;
+	calldata_get_string(data, name, &val);
+	return val;
+}
+
+// callback/signal.h and callback/proc.h
+struct signal_handler;
+typedef struct signal_handler signal_handler_t;
+typedef void (*global_signal_callback_t)(void* data, const char* signal, calldata_t* params);
+typedef void (*signal_callback_t)(void* data, calldata_t* params);
+void signal_handler_connect(signal_handler_t* handler, const char* signal, signal_callback_t callback, void* data);
+void signal_handler_disconnect(signal_handler_t* handler, const char* signal, signal_callback_t callback, void* data);
+void signal_handler_connect_global(signal_handler_t* handler, global_signal_callback_t callback, void* data);
+void signal_handler_disconnect_global(signal_handler_t* handler, global_signal_callback_t callback, void* data);
+void signal_handler_signal(signal_handler_t* handler, const char* signal, calldata_t* params);
+struct proc_handler;
+typedef struct proc_handler proc_handler_t;
+typedef void (*proc_handler_proc_t)(void* data, calldata_t* params);
+void proc_handler_add(proc_handler_t* handler, const char* decl_string, proc_handler_proc_t proc, void* data);
+bool proc_handler_call(proc_handler_t* handler, const char* name, calldata_t* params);
+
+// obs-data.h
+struct obs_data;
+struct obs_data_item;
+struct obs_data_array;
+typedef struct obs_data obs_data_t;
+typedef struct obs_data_item obs_data_item_t;
+typedef struct obs_data_array obs_data_array_t;
+obs_data_t* obs_data_create(void);
+obs_data_t* obs_data_create_from_json(const char* json_string);
+obs_data_t* obs_data_create_from_json_file_safe(const char* json_file, const char* backup_ext);
+void obs_data_addref(obs_data_t* data);
+void obs_data_release(obs_data_t* data);
+const char* obs_data_get_json(obs_data_t* data);
+const char* obs_data_get_json_pretty(obs_data_t* data);
+bool obs_data_save_json_safe(obs_data_t* data, const char* file, const char* temp_ext, const char* backup_ext);
+bool obs_data_save_json_pretty_safe(obs_data_t* data, const char* file, const char* temp_ext, const char* backup_ext);
+void obs_data_apply(obs_data_t* target, obs_data_t* apply_data);
+void obs_data_erase(obs_data_t* data, const char* name);
+void obs_data_clear(obs_data_t* data);
+bool obs_data_has_user_value(obs_data_t* data, const char* name);
+void obs_data_set_string(obs_data_t* data, const char* name, const char* val);
+void obs_data_set_int(obs_data_t* data, const char* name, long long val);
+void obs_data_set_double(obs_data_t* data, const char* name, double val);
+void obs_data_set_bool(obs_data_t* data, const char* name, bool val);
+void obs_data_set_obj(obs_data_t* data, const char* name, obs_data_t* obj);
+void obs_data_set_array(obs_data_t* data, const char* name, obs_data_array_t* array);
+void obs_data_set_default_string(obs_data_t* data, const char* name, const char* val);
+void obs_data_set_default_int(obs_data_t* data, const char* name, long long val);
+void obs_data_set_default_double(obs_data_t* data, const char* name, double val);
+void obs_data_set_default_bool(obs_data_t* data, const char* name, bool val);
+const char* obs_data_get_string(obs_data_t* data, const char* name);
+long long obs_data_get_int(obs_data_t* data, const char* name);
+double obs_data_get_double(obs_data_t* data, const char* name);
+bool obs_data_get_bool(obs_data_t* data, const char* name);
+obs_data_t* obs_data_get_obj(obs_data_t* data, const char* name);
+obs_data_array_t* obs_data_get_array(obs_data_t* data, const char* name);
+obs_data_array_t* obs_data_array_create(void);
+void obs_data_array_release(obs_data_array_t* array);
+size_t obs_data_array_count(obs_data_array_t* array);
+obs_data_t* obs_data_array_item(obs_data_array_t* array, size_t idx);
+size_t obs_data_array_push_back(obs_data_array_t* array, obs_data_t* obj);
+obs_data_item_t* obs_data_first(obs_data_t* data);
+bool obs_data_item_next(obs_data_item_t** item);
+void obs_data_item_release(obs_data_item_t** item);
+const char* obs_data_item_get_name(obs_data_item_t* item);
+
+// obs-properties.h
+struct obs_properties;
+struct obs_property;
+typedef struct obs_properties obs_properties_t;
+typedef struct obs_property obs_property_t;
+enum obs_combo_type { OBS_COMBO_TYPE_INVALID, OBS_COMBO_TYPE_EDITABLE, OBS_COMBO_TYPE_LIST, OBS_COMBO_TYPE_RADIO };
+enum obs_combo_format { OBS_COMBO_FORMAT_INVALID, OBS_COMBO_FORMAT_INT, OBS_COMBO_FORMAT_FLOAT, OBS_COMBO_FORMAT_STRING, OBS_COMBO_FORMAT_BOOL };
+enum obs_path_type { OBS_PATH_FILE, OBS_PATH_FILE_SAVE, OBS_PATH_DIRECTORY };
+enum obs_text_type { OBS_TEXT_DEFAULT, OBS_TEXT_PASSWORD, OBS_TEXT_MULTILINE, OBS_TEXT_INFO };
+enum obs_group_type { OBS_COMBO_INVALID, OBS_GROUP_NORMAL, OBS_GROUP_CHECKABLE };
+enum obs_number_type { OBS_NUMBER_SCROLLER, OBS_NUMBER_SLIDER };
+typedef bool (*obs_property_clicked_t)(obs_properties_t* props, obs_property_t* property, void* data);
+typedef bool (*obs_property_modified_t)(obs_properties_t* props, obs_property_t* property, obs_data_t* settings);
+obs_properties_t* obs_properties_create(void);
+void obs_properties_destroy(obs_properties_t* props);
+void obs_properties_set_param(obs_properties_t* props, void* param, void (*destroy)(void* param));
+void* obs_properties_get_param(obs_properties_t* props);
+obs_property_t* obs_properties_get(obs_properties_t* props, const char* property);
+obs_property_t* obs_properties_add_bool(obs_properties_t* props, const char* name, const char* description);
+obs_property_t* obs_properties_add_int(obs_properties_t* props, const char* name, const char* description, int min, int max, int step);
+obs_property_t* obs_properties_add_float(obs_properties_t* props, const char* name, const char* description, double min, double max, double step);
+obs_property_t* obs_properties_add_int_slider(obs_properties_t* props, const char* name, const char* description, int min, int max, int step);
+obs_property_t* obs_properties_add_text(obs_properties_t* props, const char* name, const char* description, enum obs_text_type type);
+obs_property_t* obs_properties_add_path(obs_properties_t* props, const char* name, const char* description, enum obs_path_type type, const char* filter, const char* default_path);
+obs_property_t* obs_properties_add_list(obs_properties_t* props, const char* name, const char* description, enum obs_combo_type type, enum obs_combo_format format);
+obs_property_t* obs_properties_add_button(obs_properties_t* props, const char* name, const char* text, obs_property_clicked_t callback);
+obs_property_t* obs_properties_add_group(obs_properties_t* props, const char* name, const char* description, enum obs_group_type type, obs_properties_t* group);
+enum obs_editable_list_type { OBS_EDITABLE_LIST_TYPE_STRINGS, OBS_EDITABLE_LIST_TYPE_FILES, OBS_EDITABLE_LIST_TYPE_FILES_AND_URLS };
+obs_property_t* obs_properties_add_editable_list(obs_properties_t* props, const char* name, const char* description, int type, const char* filter, const char* default_path);
+void obs_property_set_visible(obs_property_t* p, bool visible);
+void obs_property_set_enabled(obs_property_t* p, bool enabled);
+void obs_property_set_description(obs_property_t* p, const char* description);
+void obs_property_set_long_description(obs_property_t* p, const char* long_description);
+void obs_property_set_modified_callback(obs_property_t* p, obs_property_modified_t modified);
+size_t obs_property_list_add_string(obs_property_t* p, const char* name, const char* val);
+size_t obs_property_list_add_int(obs_property_t* p, const char* name, long long val);
+void obs_property_list_clear(obs_property_t* p);
+obs_properties_t* obs_property_group_content(obs_property_t* p);
+
+// media-io/audio-io.h
+enum audio_format { AUDIO_FORMAT_UNKNOWN, AUDIO_FORMAT_U8BIT, AUDIO_FORMAT_16BIT, AUDIO_FORMAT_32BIT, AUDIO_FORMAT_FLOAT, AUDIO_FORMAT_U8BIT_PLANAR, AUDIO_FORMAT_16BIT_PLANAR, AUDIO_FORMAT_32BIT_PLANAR, AUDIO_FORMAT_FLOAT_PLANAR };
+enum speaker_layout { SPEAKERS_UNKNOWN, SPEAKERS_MONO, SPEAKERS_STEREO, SPEAKERS_2POINT1, SPEAKERS_4POINT0, SPEAKERS_4POINT1, SPEAKERS_5POINT1, SPEAKERS_7POINT1 = 8 };
+#define MAX_AV_PLANES 8
+#define MAX_AUDIO_MIXES 6
+#define MAX_AUDIO_CHANNELS 8
+struct audio_data {
+	uint8_t* data[MAX_AV_PLANES];
+	uint32_t frames;
+	uint64_t timestamp;
+};
+typedef struct audio_output audio_t;
+uint32_t audio_output_get_sample_rate(const audio_t* audio);
+size_t audio_output_get_channels(const audio_t* audio);
+
+// media-io/video-io.h
+enum video_format { VIDEO_FORMAT_NONE, VIDEO_FORMAT_I420, VIDEO_FORMAT_NV12, VIDEO_FORMAT_Y800 = 9 };
+enum video_range_type { VIDEO_RANGE_DEFAULT, VIDEO_RANGE_PARTIAL, VIDEO_RANGE_FULL };
+struct video_data {
+	uint8_t* data[MAX_AV_PLANES];
+	uint32_t linesize[MAX_AV_PLANES];
+	uint64_t timestamp;
+};
+struct video_scale_info {
+	enum video_format format;
+	uint32_t width;
+	uint32_t height;
+	int range;
+	int colorspace;
+};
+
+// obs-source.h
+enum obs_source_type { OBS_SOURCE_TYPE_INPUT, OBS_SOURCE_TYPE_FILTER, OBS_SOURCE_TYPE_TRANSITION, OBS_SOURCE_TYPE_SCENE };
+enum obs_monitoring_type { OBS_MONITORING_TYPE_NONE, OBS_MONITORING_TYPE_MONITOR_ONLY, OBS_MONITORING_TYPE_MONITOR_AND_OUTPUT };
+#define OBS_SOURCE_VIDEO (1 << 0)
+#define OBS_SOURCE_AUDIO (1 << 1)
+#define OBS_SOURCE_ASYNC (1 << 2)
+#define OBS_SOURCE_DO_NOT_DUPLICATE (1 << 7)
+#define OBS_SOURCE_MONITOR_BY_DEFAULT (1 << 13)
+struct obs_source;
+struct obs_scene;
+struct obs_scene_item;
+struct obs_output;
+struct obs_module;
+struct obs_hotkey;
+typedef struct obs_source obs_source_t;
+typedef struct obs_scene obs_scene_t;
+typedef struct obs_weak_source obs_weak_source_t;
+typedef struct obs_scene_item obs_sceneitem_t;
+typedef struct obs_output obs_output_t;
+typedef struct obs_weak_output obs_weak_output_t;
+typedef struct obs_module obs_module_t;
+typedef struct obs_hotkey obs_hotkey_t;
+typedef size_t obs_hotkey_id;
+typedef size_t obs_hotkey_pair_id;
+#define OBS_INVALID_HOTKEY_ID (~(obs_hotkey_id)0)
+#define OBS_INVALID_HOTKEY_PAIR_ID (~(obs_hotkey_pair_id)0)
+struct obs_source_info {
+	const char* id;
+	enum obs_source_type type;
+	uint32_t output_flags;
+	const char* (*get_name)(void* type_data);
+	void* (*create)(obs_data_t* settings, obs_source_t* source);
+	void (*destroy)(void* data);
+	uint32_t (*get_width)(void* data);
+	uint32_t (*get_height)(void* data);
+	void (*get_defaults)(obs_data_t* settings);
+	obs_properties_t* (*get_properties)(void* data);
+	void (*update)(void* data, obs_data_t* settings);
+	void (*activate)(void* data);
+	void (*deactivate)(void* data);
+	void (*show)(void* data);
+	void (*hide)(void* data);
+	void (*video_tick)(void* data, float seconds);
+	void (*video_render)(void* data, void* effect);
+	void* (*filter_video)(void* data, void* frame);
+	void* (*filter_audio)(void* data, void* audio);
+	void (*enum_active_sources)(void* data, void (*enum_callback)(obs_source_t*, obs_source_t*, void*), void* param);
+	void (*save)(void* data, obs_data_t* settings);
+	void (*load)(void* data, obs_data_t* settings);
+};
+struct obs_source_audio {
+	const uint8_t* data[MAX_AV_PLANES];
+	uint32_t frames;
+	enum speaker_layout speakers;
+	enum audio_format format;
+	uint32_t samples_per_sec;
+	uint64_t timestamp;
+};
+typedef void (*obs_source_audio_capture_t)(void* param, obs_source_t* source, const struct audio_data* audio_data, bool muted);
+void obs_register_source_s(const struct obs_source_info* info, size_t size);
+#define obs_register_source(info) obs_register_source_s(info, sizeof(struct obs_source_info))
+obs_source_t* obs_source_create(const char* id, const char* name, obs_data_t* settings, obs_data_t* hotkey_data);
+obs_source_t* obs_source_create_private(const char* id, const char* name, obs_data_t* settings);
+obs_source_t* obs_load_private_source(obs_data_t* data);
+obs_data_t* obs_save_source(obs_source_t* source);
+obs_source_t* obs_source_get_ref(obs_source_t* source);
+void obs_source_release(obs_source_t* source);
+obs_weak_source_t* obs_source_get_weak_source(obs_source_t* source);
+void obs_weak_source_release(obs_weak_source_t* weak);
+bool obs_weak_source_references_source(obs_weak_source_t* weak, obs_source_t* source);
+void obs_source_remove(obs_source_t* source);
+bool obs_source_removed(const obs_source_t* source);
+obs_data_t* obs_source_get_settings(const obs_source_t* source);
+obs_data_t* obs_source_get_private_settings(obs_source_t* item);
+void obs_source_update(obs_source_t* source, obs_data_t* settings);
+const char* obs_source_get_name(const obs_source_t* source);
+const char* obs_source_get_id(const obs_source_t* source);
+const char* obs_source_get_uuid(const obs_source_t* source);
+const char* obs_source_get_display_name(const char* id);
+enum obs_source_type obs_source_get_type(const obs_source_t* source);
+uint32_t obs_source_get_output_flags(const obs_source_t* source);
+float obs_source_get_volume(const obs_source_t* source);
+void obs_source_set_volume(obs_source_t* source, float volume);
+float obs_source_get_balance_value(const obs_source_t* source);
+bool obs_source_muted(const obs_source_t* source);
+void obs_source_set_muted(obs_source_t* source, bool muted);
+bool obs_source_showing(const obs_source_t* source);
+bool obs_source_active(const obs_source_t* source);
+void obs_source_set_monitoring_type(obs_source_t* source, enum obs_monitoring_type type);
+enum obs_monitoring_type obs_source_get_monitoring_type(const obs_source_t* source);
+void obs_source_inc_active(obs_source_t* source);
+void obs_source_dec_active(obs_source_t* source);
+void obs_source_inc_showing(obs_source_t* source);
+void obs_source_dec_showing(obs_source_t* source);
+void obs_source_output_audio(obs_source_t* source, const struct obs_source_audio* audio);
+signal_handler_t* obs_source_get_signal_handler(const obs_source_t* source);
+proc_handler_t* obs_source_get_proc_handler(const obs_source_t* source);
+void obs_source_add_audio_capture_callback(obs_source_t* source, obs_source_audio_capture_t callback, void* param);
+void obs_source_remove_audio_capture_callback(obs_source_t* source, obs_source_audio_capture_t callback, void* param);
+obs_source_t* obs_get_source_by_name(const char* name);
+void obs_source_set_name(obs_source_t* source, const char* name);
+obs_source_t* obs_get_source_by_uuid(const char* uuid);
+void obs_enum_sources(bool (*enum_proc)(void*, obs_source_t*), void* param);
+
+// obs-scene.h
+obs_scene_t* obs_scene_from_source(const obs_source_t* source);
+obs_source_t* obs_scene_get_source(const obs_scene_t* scene);
+void obs_scene_enum_items(obs_scene_t* scene, bool (*callback)(obs_scene_t*, obs_sceneitem_t*, void*), void* param);
+obs_source_t* obs_sceneitem_get_source(const obs_sceneitem_t* item);
+obs_scene_t* obs_sceneitem_get_scene(const obs_sceneitem_t* item);
+int64_t obs_sceneitem_get_id(const obs_sceneitem_t* item);
+bool obs_sceneitem_visible(const obs_sceneitem_t* item);
+bool obs_sceneitem_set_visible(obs_sceneitem_t* item, bool visible);
+obs_sceneitem_t* obs_scene_add(obs_scene_t* scene, obs_source_t* source);
+void obs_sceneitem_remove(obs_sceneitem_t* item);
+void obs_enum_scenes(bool (*enum_proc)(void*, obs_source_t*), void* param);
+obs_scene_t* obs_scene_create(const char* name);
+void obs_scene_release(obs_scene_t* scene);
+
+// obs-output.h
+obs_output_t* obs_output_get_ref(obs_output_t* output);
+void obs_output_release(obs_output_t* output);
+obs_weak_output_t* obs_output_get_weak_output(obs_output_t* output);
+obs_output_t* obs_weak_output_get_output(obs_weak_output_t* weak);
+void obs_weak_output_release(obs_weak_output_t* weak);
+bool obs_output_active(const obs_output_t* output);
+uint64_t obs_output_get_total_bytes(const obs_output_t* output);
+int obs_output_get_frames_dropped(const obs_output_t* output);
+int obs_output_get_total_frames(const obs_output_t* output);
+float obs_output_get_congestion(obs_output_t* output);
+bool obs_output_reconnecting(const obs_output_t* output);
+
+// obs.h
+signal_handler_t* obs_get_signal_handler(void);
+proc_handler_t* obs_get_proc_handler(void);
+const char* obs_get_locale(void);
+uint32_t obs_get_total_frames(void);
+uint32_t obs_get_lagged_frames(void);
+double obs_get_active_fps(void);
+uint64_t obs_get_average_frame_time_ns(void);
+typedef struct video_output video_t;
+video_t* obs_get_video(void);
+audio_t* obs_get_audio(void);
+uint32_t video_output_get_skipped_frames(const video_t* video);
+uint32_t video_output_get_total_frames(const video_t* video);
+void obs_add_raw_video_callback(const struct video_scale_info* conversion, void (*callback)(void* param, struct video_data* frame), void* param);
+void obs_add_raw_video_callback2(const struct video_scale_info* conversion, uint32_t frame_rate_divisor, void (*callback)(void* param, struct video_data* frame), void* param);
+void obs_remove_raw_video_callback(void (*callback)(void* param, struct video_data* frame), void* param);
+const char* obs_get_module_binary_path(obs_module_t* module);
+enum obs_task_type { OBS_TASK_UI, OBS_TASK_GRAPHICS, OBS_TASK_AUDIO, OBS_TASK_DESTROY };
+typedef void (*obs_task_t)(void* param);
+void obs_queue_task(enum obs_task_type type, obs_task_t task, void* param, bool wait);
+
+// obs-hotkey.h
+typedef void (*obs_hotkey_func)(void* data, obs_hotkey_id id, obs_hotkey_t* hotkey, bool pressed);
+typedef bool (*obs_hotkey_active_func)(void* data, obs_hotkey_pair_id id, obs_hotkey_t* hotkey, bool pressed);
+obs_hotkey_id obs_hotkey_register_frontend(const char* name, const char* description, obs_hotkey_func func, void* data);
+void obs_hotkey_unregister(obs_hotkey_id id);
+obs_hotkey_pair_id obs_hotkey_pair_register_frontend(const char* name0, const char* description0, const char* name1, const char* description1, obs_hotkey_active_func func0, obs_hotkey_active_func func1, void* data0, void* data1);
+void obs_hotkey_pair_unregister(obs_hotkey_pair_id id);
+void obs_hotkey_load(obs_hotkey_id id, obs_data_array_t* data);
+void obs_hotkey_pair_load(obs_hotkey_pair_id id, obs_data_array_t* data0, obs_data_array_t* data1);
+obs_data_array_t* obs_hotkey_save(obs_hotkey_id id);
+const char* obs_hotkey_get_name(const obs_hotkey_t* key);
+obs_hotkey_id obs_hotkey_get_id(const obs_hotkey_t* key);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,53 @@
+/*
+ OBS Accessibility
+ Copyright (C) 2025 Sam Tupy Productions <webmaster@samtupy.com>
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along
+ with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+// Stand-in for libobs obs.hpp, providing the reference-holding wrappers the plugin uses.
+#pragma once
+#include <utility>
+#include <obs.h>
+
+template<typename T, void release(T)> class OBSRefAutoRelease {
+	T val = nullptr;
+public:
+	OBSRefAutoRelease() = default;
+	OBSRefAutoRelease(T val_) : val(val_) {}
+	OBSRefAutoRelease(std::nullptr_t) {}
+	OBSRefAutoRelease(const OBSRefAutoRelease&) = delete;
+	OBSRefAutoRelease(OBSRefAutoRelease&& other) : val(other.val) { other.val = nullptr; }
+	~OBSRefAutoRelease() { if (val) release(val); }
+	OBSRefAutoRelease& operator=(const OBSRefAutoRelease&) = delete;
+	OBSRefAutoRelease& operator=(OBSRefAutoRelease&& other) {
+		if (this != &other) {
+			if (val) release(val);
+			val = other.val;
+			other.val = nullptr;
+		}
+		return *this;
+	}
+	OBSRefAutoRelease& operator=(T new_val) {
+		if (val) release(val);
+		val = new_val;
+		return *this;
+	}
+	operator T() const { return val; }
+	T Get() const { return val; }
+};
+using OBSDataAutoRelease = OBSRefAutoRelease<obs_data_t*, obs_data_release>;
+using OBSDataArrayAutoRelease = OBSRefAutoRelease<obs_data_array_t*, obs_data_array_release>;
+using OBSSourceAutoRelease = OBSRefAutoRelease<obs_source_t*, obs_source_release>;
+using OBSOutputAutoRelease = OBSRefAutoRelease<obs_output_t*, obs_output_release>;
@@ -0,0 +1,68 @@
+/*
+ OBS Accessibility
+ Copyright (C) 2025 Sam Tupy Productions <webmaster@samtupy.com>
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along
+ with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+// Stand-in for prism.h. The stub registry exposes a single in-process backend which records every utterance instead of speaking it, see obs-stub.h.
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct PrismContext PrismContext;
+typedef struct PrismBackend PrismBackend;
+typedef struct PrismConfig PrismConfig;
+typedef uint64_t PrismBackendId;
+typedef enum PrismError {
+	PRISM_OK = 0,
+	PRISM_ERROR_NOT_INITIALIZED,
+	PRISM_ERROR_INVALID_PARAM,
+	PRISM_ERROR_NOT_IMPLEMENTED,
+	PRISM_ERROR_NO_VOICES,
+	PRISM_ERROR_VOICE_NOT_FOUND,
+	PRISM_ERROR_SPEAK_FAILURE,
+	PRISM_ERROR_MEMORY_FAILURE,
+	PRISM_ERROR_RANGE_OUT_OF_BOUNDS,
+	PRISM_ERROR_INTERNAL,
+	PRISM_ERROR_NOT_SPEAKING,
+	PRISM_ERROR_NOT_PAUSED,
+	PRISM_ERROR_ALREADY_PAUSED,
+	PRISM_ERROR_INVALID_UTF8,
+	PRISM_ERROR_INVALID_OPERATION,
+	PRISM_ERROR_ALREADY_INITIALIZED,
+	PRISM_ERROR_BACKEND_NOT_AVAILABLE,
+	PRISM_ERROR_UNKNOWN
+} PrismError;
+PrismContext* prism_init(PrismConfig* cfg);
+void prism_shutdown(PrismContext* ctx);
+size_t prism_registry_count(PrismContext* ctx);
+PrismBackendId prism_registry_id_at(PrismContext* ctx, size_t index);
+const char* prism_registry_name(PrismContext* ctx, PrismBackendId id);
+PrismBackend* prism_registry_create(PrismContext* ctx, PrismBackendId id);
+PrismBackend* prism_registry_acquire_best(PrismContext* ctx);
+void prism_backend_free(PrismBackend* backend);
+const char* prism_backend_name(PrismBackend* backend);
+PrismError prism_backend_initialize(PrismBackend* backend);
+PrismError prism_backend_speak(PrismBackend* backend, const char* text, bool interrupt);
+PrismError prism_backend_stop(PrismBackend* backend);
+
+#ifdef __cplusplus
+}
+#endif
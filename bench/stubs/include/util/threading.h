@@ -0,0 +1,59 @@
+/*
+ OBS Accessibility
+ Copyright (C) 2025 Sam Tupy Productions <webmaster@samtupy.com>
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along
+ with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+// Stand-in for libobs util/threading.h, see obs.h.
+#pragma once
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#ifdef _WIN32
+	#include <thread>
+	typedef std::thread* pthread_t;
+	inline int pthread_create(pthread_t* thread, const void*, void* (*func)(void*), void* arg) {
+		*thread = new std::thread(func, arg);
+		return 0;
+	}
+	inline int pthread_join(pthread_t thread, void** ret) {
+		thread->join();
+		delete thread;
+		if (ret) *ret = nullptr;
+		return 0;
+	}
+#else
+	#include <pthread.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum os_event_type { OS_EVENT_TYPE_AUTO, OS_EVENT_TYPE_MANUAL };
+struct os_event_data;
+typedef struct os_event_data os_event_t;
+int os_event_init(os_event_t** event, enum os_event_type type);
+void os_event_destroy(os_event_t* event);
+int os_event_wait(os_event_t* event);
+int os_event_timedwait(os_event_t* event, unsigned long milliseconds);
+int os_event_try(os_event_t* event);
+int os_event_signal(os_event_t* event);
+void os_event_reset(os_event_t* event);
+void os_set_thread_name(const char* name);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,1177 @@
+/*
+ OBS Accessibility
+ Copyright (C) 2025 Sam Tupy Productions <webmaster@samtupy.com>
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along
+ with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+// In-process implementation of the libobs subset declared in include/obs.h. Nothing here tries to be complete, only faithful enough that the plugin core behaves as it would inside OBS.
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <obs.h>
+#include <obs-module.h>
+#include <obs-stub.h>
+
+using namespace std;
+
+// plugin-support, normally generated from third_party/plugin-support.c.in.
+extern "C" {
+const char* PLUGIN_NAME = "obs-accessibility";
+const char* PLUGIN_VERSION = "bench";
+void obs_log(int log_level, const char* format, ...) {
+	char buffer[1024];
+	snprintf(buffer, sizeof(buffer), "[%s] %s", PLUGIN_NAME, format);
+	va_list args;
+	va_start(args, format);
+	blogva(log_level, buffer, args);
+	va_end(args);
+}
+}
+
+// util/base.h
+static void default_log_handler(int lvl, const char* msg, va_list args, void*) {
+	if (lvl > LOG_WARNING && !getenv("BENCH_VERBOSE")) return;
+	vfprintf(stderr, msg, args);
+	fputc('\n', stderr);
+}
+static log_handler_t g_log_handler = default_log_handler;
+static void* g_log_param = nullptr;
+void blogva(int log_level, const char* format, va_list args) { g_log_handler(log_level, format, args, g_log_param); }
+void blog(int log_level, const char* format, ...) {
+	va_list args;
+	va_start(args, format);
+	blogva(log_level, format, args);
+	va_end(args);
+}
+void base_get_log_handler(log_handler_t* handler, void** param) {
+	if (handler) *handler = g_log_handler;
+	if (param) *param = g_log_param;
+}
+void base_set_log_handler(log_handler_t handler, void* param) {
+	g_log_handler = handler? handler : default_log_handler;
+	g_log_param = param;
+}
+
+// util/bmem.h
+void* bmalloc(size_t size) { return malloc(size? size : 1); }
+void* bzalloc(size_t size) { return calloc(1, size? size : 1); }
+void bfree(void* ptr) { free(ptr); }
+char* bstrdup(const char* str) {
+	if (!str) return nullptr;
+	size_t len = strlen(str) + 1;
+	char* out = (char*)bmalloc(len);
+	memcpy(out, str, len);
+	return out;
+}
+
+// util/platform.h
+uint64_t os_gettime_ns(void) { return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count(); }
+bool os_sleepto_ns(uint64_t time_target) {
+	uint64_t now = os_gettime_ns();
+	if (now >= time_target) return false;
+	this_thread::sleep_for(chrono::nanoseconds(time_target - now));
+	return true;
+}
+void os_sleep_ms(uint32_t duration) { this_thread::sleep_for(chrono::milliseconds(duration)); }
+int os_mkdirs(const char* path) {
+	error_code ec;
+	if (filesystem::is_directory(path, ec)) return 1;
+	return filesystem::create_directories(path, ec)? 0 : -1;
+}
+int os_mkdir(const char* path) { return os_mkdirs(path); }
+int os_unlink(const char* path) {
+	error_code ec;
+	return filesystem::remove(path, ec)? 0 : -1;
+}
+int os_rename(const char* old_path, const char* new_path) {
+	error_code ec;
+	filesystem::rename(old_path, new_path, ec);
+	return ec? -1 : 0;
+}
+bool os_file_exists(const char* path) {
+	error_code ec;
+	return filesystem::exists(path, ec);
+}
+int64_t os_get_file_size(const char* path) {
+	error_code ec;
+	uintmax_t size = filesystem::file_size(path, ec);
+	return ec? -1 : (int64_t)size;
+}
+
+// util/threading.h
+struct os_event_data {
+	mutex lock;
+	condition_variable cond;
+	bool signalled = false;
+	bool manual = false;
+};
+int os_event_init(os_event_t** event, enum os_event_type type) {
+	*event = new os_event_data();
+	(*event)->manual = type == OS_EVENT_TYPE_MANUAL;
+	return 0;
+}
+void os_event_destroy(os_event_t* event) { delete event; }
+int os_event_wait(os_event_t* event) {
+	unique_lock<mutex> l(event->lock);
+	event->cond.wait(l, [event] { return event->signalled; });
+	if (!event->manual) event->signalled = false;
+	return 0;
+}
+int os_event_timedwait(os_event_t* event, unsigned long milliseconds) {
+	unique_lock<mutex> l(event->lock);
+	if (!event->cond.wait_for(l, chrono::milliseconds(milliseconds), [event] { return event->signalled; })) return ETIMEDOUT;
+	if (!event->manual) event->signalled = false;
+	return 0;
+}
+int os_event_try(os_event_t* event) {
+	lock_guard<mutex> l(event->lock);
+	if (!event->signalled) return EAGAIN;
+	if (!event->manual) event->signalled = false;
+	return 0;
+}
+int os_event_signal(os_event_t* event) {
+	{
+		lock_guard<mutex> l(event->lock);
+		event->signalled = true;
+	}
+	event->cond.notify_all();
+	return 0;
+}
+void os_event_reset(os_event_t* event) {
+	lock_guard<mutex> l(event->lock);
+	event->signalled = false;
+}
+void os_set_thread_name(const char*) {}
+
+// callback/calldata.h, using the same stack layout as libobs: repeated [size_t name_size][name][size_t data_size][data], terminated by a zero name size.
+static inline bool cd_ensure_capacity(calldata_t* data, size_t pos, size_t size) {
+	if (data->capacity >= pos + size) return true;
+	if (data->fixed) return false;
+	size_t capacity = data->capacity? data->capacity * 2 : 128;
+	while (capacity < pos + size) capacity *= 2;
+	data->stack = (uint8_t*)realloc(data->stack, capacity);
+	data->capacity = capacity;
+	return true;
+}
+static bool cd_find(const calldata_t* data, const char* name, uint8_t** pos) {
+	if (!data || !data->stack || !name) return false;
+	size_t name_len = strlen(name) + 1;
+	uint8_t* p = data->stack;
+	for (;;) {
+		size_t name_size = *(size_t*)p;
+		if (!name_size) return false;
+		p += sizeof(size_t);
+		if (name_size == name_len && memcmp(p, name, name_len) == 0) {
+			*pos = p + name_size;
+			return true;
+		}
+		p += name_size;
+		p += *(size_t*)p + sizeof(size_t);
+	}
+}
+void calldata_init(calldata_t* data) { memset(data, 0, sizeof(calldata_t)); }
+void calldata_init_fixed(calldata_t* data, uint8_t* stack, size_t size) {
+	data->stack = stack;
+	data->capacity = size;
+	data->fixed = true;
+	data->size = 0;
+	calldata_clear(data);
+}
+void calldata_free(calldata_t* data) {
+	if (!data->fixed) free(data->stack);
+}
+bool calldata_get_data(const calldata_t* data, const char* name, void* out, size_t size) {
+	uint8_t* pos;
+	if (!cd_find(data, name, &pos)) return false;
+	size_t data_size = *(size_t*)pos;
+	if (data_size != size) return false;
+	memcpy(out, pos + sizeof(size_t), size);
+	return true;
+}
+void calldata_set_data(calldata_t* data, const char* name, const void* in, size_t new_size) {
+	if (!data || !name) return;
+	if (!data->stack) {
+		if (!cd_ensure_capacity(data, 0, sizeof(size_t))) return;
+		memset(data->stack, 0, sizeof(size_t));
+		data->size = sizeof(size_t);
+	}
+	uint8_t* pos;
+	if (cd_find(data, name, &pos)) {
+		size_t offset = pos - data->stack;
+		size_t old_size = *(size_t*)pos;
+		size_t tail = offset + sizeof(size_t) + old_size;
+		if (new_size > old_size && !cd_ensure_capacity(data, data->size, new_size - old_size)) return;
+		pos = data->stack + offset;
+		memmove(pos + sizeof(size_t) + new_size, data->stack + tail, data->size - tail);
+		data->size = data->size - old_size + new_size;
+		*(size_t*)pos = new_size;
+		if (new_size) memcpy(pos + sizeof(size_t), in, new_size);
+		return;
+	}
+	size_t name_size = strlen(name) + 1;
+	size_t offset = data->size - sizeof(size_t);
+	if (!cd_ensure_capacity(data, data->size, name_size + new_size + sizeof(size_t) * 2)) return;
+	uint8_t* p = data->stack + offset;
+	*(size_t*)p = name_size;
+	p += sizeof(size_t);
+	memcpy(p, name, name_size);
+	p += name_size;
+	*(size_t*)p = new_size;
+	p += sizeof(size_t);
+	if (new_size) memcpy(p, in, new_size);
+	p += new_size;
+	*(size_t*)p = 0;
+	data->size = offset + name_size + new_size + sizeof(size_t) * 3;
+}
+bool calldata_get_string(const calldata_t* data, const char* name, const char** str) {
+	uint8_t* pos;
+	if (!cd_find(data, name, &pos)) return false;
+	*str = *(size_t*)pos? (const char*)(pos + sizeof(size_t)) : nullptr;
+	return true;
+}
+
+// callback/signal.h and callback/proc.h
+struct signal_handler {
+	recursive_mutex lock;
+	vector<pair<global_signal_callback_t, void*>> global_callbacks;
+	multimap<string, pair<signal_callback_t, void*>> callbacks;
+};
+void signal_handler_connect(signal_handler_t* handler, const char* signal, signal_callback_t callback, void* data) {
+	if (!handler) return;
+	lock_guard<recursive_mutex> l(handler->lock);
+	handler->callbacks.emplace(signal, make_pair(callback, data));
+}
+void signal_handler_disconnect(signal_handler_t* handler, const char* signal, signal_callback_t callback, void* data) {
+	if (!handler) return;
+	lock_guard<recursive_mutex> l(handler->lock);
+	auto range = handler->callbacks.equal_range(signal);
+	for (auto i = range.first; i != range.second; i++) {
+		if (i->second.first != callback || i->second.second != data) continue;
+		handler->callbacks.erase(i);
+		return;
+	}
+}
+void signal_handler_connect_global(signal_handler_t* handler, global_signal_callback_t callback, void* data) {
+	if (!handler) return;
+	lock_guard<recursive_mutex> l(handler->lock);
+	handler->global_callbacks.emplace_back(callback, data);
+}
+void signal_handler_disconnect_global(signal_handler_t* handler, global_signal_callback_t callback, void* data) {
+	if (!handler) return;
+	lock_guard<recursive_mutex> l(handler->lock);
+	erase(handler->global_callbacks, make_pair(callback, data));
+}
+void signal_handler_signal(signal_handler_t* handler, const char* signal, calldata_t* params) {
+	if (!handler) return;
+	lock_guard<recursive_mutex> l(handler->lock);
+	auto range = handler->callbacks.equal_range(signal);
+	for (auto i = range.first; i != range.second; i++) i->second.first(i->second.second, params);
+	for (auto& i : handler->global_callbacks) i.first(i.second, signal, params);
+}
+struct proc_handler {
+	mutex lock;
+	unordered_map<string, pair<proc_handler_proc_t, void*>> procs;
+};
+void proc_handler_add(proc_handler_t* handler, const char* decl_string, proc_handler_proc_t proc, void* data) {
+	// Only the name is needed from a declaration such as "void name(in int x, out bool y)".
+	string decl = decl_string;
+	size_t end = decl.find('(');
+	if (end == string::npos) return;
+	size_t start = decl.rfind(' ', end);
+	start = start == string::npos? 0 : start + 1;
+	lock_guard<mutex> l(handler->lock);
+	handler->procs[decl.substr(start, end - start)] = make_pair(proc, data);
+}
+bool proc_handler_call(proc_handler_t* handler, const char* name, calldata_t* params) {
+	pair<proc_handler_proc_t, void*> proc;
+	{
+		lock_guard<mutex> l(handler->lock);
+		auto it = handler->procs.find(name);
+		if (it == handler->procs.end()) return false;
+		proc = it->second;
+	}
+	proc.first(proc.second, params);
+	return true;
+}
+static signal_handler_t g_core_signals;
+static proc_handler_t g_core_procs;
+signal_handler_t* obs_get_signal_handler(void) { return &g_core_signals; }
+proc_handler_t* obs_get_proc_handler(void) { return &g_core_procs; }
+void obs_queue_task(enum obs_task_type, obs_task_t task, void* param, bool) { task(param); } // There is no UI thread to hand tasks to, so they run on the caller's.
+const char* obs_get_locale(void) { return "en-US"; }
+void stub_emit_signal(const char* signal, calldata_t* data) { signal_handler_signal(&g_core_signals, signal, data); }
+
+// obs-data.h
+enum data_type { DATA_NULL, DATA_BOOL, DATA_INT, DATA_DOUBLE, DATA_STRING, DATA_OBJ, DATA_ARRAY };
+struct data_value {
+	data_type type = DATA_NULL;
+	bool b = false;
+	long long i = 0;
+	double d = 0.0;
+	string s;
+	obs_data_t* obj = nullptr;
+	obs_data_array_t* arr = nullptr;
+};
+struct obs_data_item {
+	string name;
+	bool has_user = false, has_default = false;
+	data_value user, def;
+	obs_data_t* parent = nullptr;
+};
+struct obs_data {
+	atomic_long refs = 1;
+	map<string, obs_data_item> items;
+	string json;
+};
+struct obs_data_array {
+	atomic_long refs = 1;
+	vector<obs_data_t*> objects;
+};
+static void release_value(data_value& v) {
+	if (v.obj) obs_data_release(v.obj);
+	if (v.arr) obs_data_array_release(v.arr);
+	v = data_value();
+}
+static obs_data_item* get_item(obs_data_t* data, const char* name, bool create) {
+	if (!data || !name) return nullptr;
+	auto it = data->items.find(name);
+	if (it != data->items.end()) return &it->second;
+	if (!create) return nullptr;
+	obs_data_item& item = data->items[name];
+	item.name = name;
+	item.parent = data;
+	return &item;
+}
+static const data_value* get_value(obs_data_t* data, const char* name) {
+	obs_data_item* item = get_item(data, name, false);
+	if (!item) return nullptr;
+	if (item->has_user) return &item->user;
+	return item->has_default? &item->def : nullptr;
+}
+static data_value& set_user(obs_data_t* data, const char* name, data_type type) {
+	static data_value sink;
+	obs_data_item* item = get_item(data, name, true);
+	if (!item) return sink = data_value();
+	release_value(item->user);
+	item->has_user = true;
+	item->user.type = type;
+	return item->user;
+}
+static data_value& set_default(obs_data_t* data, const char* name, data_type type) {
+	static data_value sink;
+	obs_data_item* item = get_item(data, name, true);
+	if (!item) return sink = data_value();
+	release_value(item->def);
+	item->has_default = true;
+	item->def.type = type;
+	return item->def;
+}
+static void json_escape(string& out, const string& in) {
+	out += '"';
+	for (char c : in) {
+		if (c == '"' || c == '\\') out += '\\';
+		if (c == '\n') {
+			out += "\\n";
+			continue;
+		}
+		out += c;
+	}
+	out += '"';
+}
+static void json_write(string& out, obs_data_t* data);
+static void json_write_value(string& out, const data_value& v) {
+	switch (v.type) {
+		case DATA_BOOL: out += v.b? "true" : "false"; break;
+		case DATA_INT: out += to_string(v.i); break;
+		case DATA_DOUBLE: out += to_string(v.d); break;
+		case DATA_STRING: json_escape(out, v.s); break;
+		case DATA_OBJ: json_write(out, v.obj); break;
+		case DATA_ARRAY:
+			out += '[';
+			for (size_t i = 0; i < v.arr->objects.size(); i++) {
+				if (i) out += ',';
+				json_write(out, v.arr->objects[i]);
+			}
+			out += ']';
+			break;
+		default: out += "null";
+	}
+}
+static void json_write(string& out, obs_data_t* data) {
+	out += '{';
+	bool first = true;
+	for (auto& i : data->items) {
+		if (!i.second.has_user) continue;
+		if (!first) out += ',';
+		first = false;
+		json_escape(out, i.first);
+		out += ':';
+		json_write_value(out, i.second.user);
+	}
+	out += '}';
+}
+static bool json_save_safe(const string& json, const char* file, const char* temp_ext, const char* backup_ext) {
+	string temp = string(file) + temp_ext;
+	{
+		ofstream f(temp, ios::binary | ios::trunc);
+		if (!f) return false;
+		f << json;
+		if (!f) return false;
+	}
+	if (backup_ext && os_file_exists(file)) os_rename(file, (string(file) + backup_ext).c_str());
+	return os_rename(temp.c_str(), file) == 0;
+}
+obs_data_t* obs_data_create(void) { return new obs_data(); }
+obs_data_t* obs_data_create_from_json(const char*) { return obs_data_create(); } // The stub does not parse json, the harness always starts from default settings.
+obs_data_t* obs_data_create_from_json_file_safe(const char*, const char*) { return nullptr; }
+void obs_data_addref(obs_data_t* data) {
+	if (data) data->refs++;
+}
+void obs_data_release(obs_data_t* data) {
+	if (!data || --data->refs > 0) return;
+	for (auto& i : data->items) {
+		release_value(i.second.user);
+		release_value(i.second.def);
+	}
+	delete data;
+}
+const char* obs_data_get_json(obs_data_t* data) {
+	if (!data) return nullptr;
+	data->json.clear();
+	json_write(data->json, data);
+	return data->json.c_str();
+}
+const char* obs_data_get_json_pretty(obs_data_t* data) { return obs_data_get_json(data); }
+bool os_quick_write_utf8_file_safe(const char* path, const char* str, size_t len, bool, const char* temp_ext, const char* backup_ext) { return path && str && json_save_safe(string(str, len), path, temp_ext, backup_ext); }
+bool obs_data_save_json_safe(obs_data_t* data, const char* file, const char* temp_ext, const char* backup_ext) { return data && json_save_safe(obs_data_get_json(data), file, temp_ext, backup_ext); }
+bool obs_data_save_json_pretty_safe(obs_data_t* data, const char* file, const char* temp_ext, const char* backup_ext) { return obs_data_save_json_safe(data, file, temp_ext, backup_ext); }
+void obs_data_apply(obs_data_t* target, obs_data_t* apply_data) {
+	if (!target || !apply_data || target == apply_data) return;
+	for (auto& i : apply_data->items) {
+		if (!i.second.has_user) continue;
+		data_value& v = set_user(target, i.first.c_str(), i.second.user.type);
+		v = i.second.user;
+		if (v.obj) obs_data_addref(v.obj);
+		if (v.arr) v.arr->refs++;
+	}
+}
+void obs_data_erase(obs_data_t* data, const char* name) {
+	obs_data_item* item = get_item(data, name, false);
+	if (!item) return;
+	release_value(item->user);
+	release_value(item->def);
+	data->items.erase(name);
+}
+void obs_data_clear(obs_data_t* data) {
+	if (!data) return;
+	for (auto& i : data->items) {
+		release_value(i.second.user);
+		i.second.has_user = false;
+	}
+}
+bool obs_data_has_user_value(obs_data_t* data, const char* name) {
+	obs_data_item* item = get_item(data, name, false);
+	return item && item->has_user;
+}
+void obs_data_set_string(obs_data_t* data, const char* name, const char* val) { set_user(data, name, DATA_STRING).s = val? val : ""; }
+void obs_data_set_int(obs_data_t* data, const char* name, long long val) { set_user(data, name, DATA_INT).i = val; }
+void obs_data_set_double(obs_data_t* data, const char* name, double val) { set_user(data, name, DATA_DOUBLE).d = val; }
+void obs_data_set_bool(obs_data_t* data, const char* name, bool val) { set_user(data, name, DATA_BOOL).b = val; }
+void obs_data_set_obj(obs_data_t* data, const char* name, obs_data_t* obj) {
+	obs_data_addref(obj);
+	set_user(data, name, DATA_OBJ).obj = obj;
+}
+void obs_data_set_array(obs_data_t* data, const char* name, obs_data_array_t* array) {
+	if (array) array->refs++;
+	set_user(data, name, DATA_ARRAY).arr = array;
+}
+void obs_data_set_default_string(obs_data_t* data, const char* name, const char* val) { set_default(data, name, DATA_STRING).s = val? val : ""; }
+void obs_data_set_default_int(obs_data_t* data, const char* name, long long val) { set_default(data, name, DATA_INT).i = val; }
+void obs_data_set_default_double(obs_data_t* data, const char* name, double val) { set_default(data, name, DATA_DOUBLE).d = val; }
+void obs_data_set_default_bool(obs_data_t* data, const char* name, bool val) { set_default(data, name, DATA_BOOL).b = val; }
+const char* obs_data_get_string(obs_data_t* data, const char* name) {
+	const data_value* v = get_value(data, name);
+	return v && v->type == DATA_STRING? v->s.c_str() : "";
+}
+long long obs_data_get_int(obs_data_t* data, const char* name) {
+	const data_value* v = get_value(data, name);
+	if (!v) return 0;
+	return v->type == DATA_DOUBLE? (long long)v->d : v->i;
+}
+double obs_data_get_double(obs_data_t* data, const char* name) {
+	const data_value* v = get_value(data, name);
+	if (!v) return 0.0;
+	return v->type == DATA_INT? (double)v->i : v->d;
+}
+bool obs_data_get_bool(obs_data_t* data, const char* name) {
+	const data_value* v = get_value(data, name);
+	return v && v->b;
+}
+obs_data_t* obs_data_get_obj(obs_data_t* data, const char* name) {
+	const data_value* v = get_value(data, name);
+	if (!v || !v->obj) return nullptr;
+	obs_data_addref(v->obj);
+	return v->obj;
+}
+obs_data_array_t* obs_data_get_array(obs_data_t* data, const char* name) {
+	const data_value* v = get_value(data, name);
+	if (!v || !v->arr) return nullptr;
+	v->arr->refs++;
+	return v->arr;
+}
+obs_data_array_t* obs_data_array_create(void) { return new obs_data_array(); }
+void obs_data_array_release(obs_data_array_t* array) {
+	if (!array || --array->refs > 0) return;
+	for (obs_data_t* d : array->objects) obs_data_release(d);
+	delete array;
+}
+size_t obs_data_array_count(obs_data_array_t* array) { return array? array->objects.size() : 0; }
+obs_data_t* obs_data_array_item(obs_data_array_t* array, size_t idx) {
+	if (!array || idx >= array->objects.size()) return nullptr;
+	obs_data_addref(array->objects[idx]);
+	return array->objects[idx];
+}
+size_t obs_data_array_push_back(obs_data_array_t* array, obs_data_t* obj) {
+	obs_data_addref(obj);
+	array->objects.push_back(obj);
+	return array->objects.size() - 1;
+}
+obs_data_item_t* obs_data_first(obs_data_t* data) {
+	if (!data || data->items.empty()) return nullptr;
+	return &data->items.begin()->second;
+}
+bool obs_data_item_next(obs_data_item_t** item) {
+	if (!item || !*item) return false;
+	auto it = (*item)->parent->items.find((*item)->name);
+	*item = ++it == (*item)->parent->items.end()? nullptr : &it->second;
+	return *item != nullptr;
+}
+void obs_data_item_release(obs_data_item_t** item) {
+	if (item) *item = nullptr;
+}
+const char* obs_data_item_get_name(obs_data_item_t* item) { return item? item->name.c_str() : nullptr; }
+
+// obs-properties.h, properties are kept just well enough for get_properties callbacks to run.
+struct obs_property {
+	string name, description;
+	bool visible = true, enabled = true;
+	obs_properties_t* group = nullptr;
+	vector<pair<string, string>> list;
+};
+struct obs_properties {
+	void* param = nullptr;
+	void (*destroy)(void*) = nullptr;
+	vector<obs_property*> props;
+};
+obs_properties_t* obs_properties_create(void) { return new obs_properties(); }
+void obs_properties_destroy(obs_properties_t* props) {
+	if (!props) return;
+	if (props->destroy) props->destroy(props->param);
+	for (obs_property* p : props->props) {
+		obs_properties_destroy(p->group);
+		delete p;
+	}
+	delete props;
+}
+void obs_properties_set_param(obs_properties_t* props, void* param, void (*destroy)(void*)) {
+	props->param = param;
+	props->destroy = destroy;
+}
+void* obs_properties_get_param(obs_properties_t* props) { return props? props->param : nullptr; }
+obs_property_t* obs_properties_get(obs_properties_t* props, const char* property) {
+	if (!props) return nullptr;
+	for (obs_property* p : props->props) {
+		if (p->name == property) return p;
+		if (obs_property* sub = obs_properties_get(p->group, property)) return sub;
+	}
+	return nullptr;
+}
+static obs_property_t* add_property(obs_properties_t* props, const char* name, const char* description) {
+	obs_property* p = new obs_property();
+	p->name = name? name : "";
+	p->description = description? description : "";
+	props->props.push_back(p);
+	return p;
+}
+obs_property_t* obs_properties_add_bool(obs_properties_t* props, const char* name, const char* description) { return add_property(props, name, description); }
+obs_property_t* obs_properties_add_int(obs_properties_t* props, const char* name, const char* description, int, int, int) { return add_property(props, name, description); }
+obs_property_t* obs_properties_add_float(obs_properties_t* props, const char* name, const char* description, double, double, double) { return add_property(props, name, description); }
+obs_property_t* obs_properties_add_int_slider(obs_properties_t* props, const char* name, const char* description, int, int, int) { return add_property(props, name, description); }
+obs_property_t* obs_properties_add_text(obs_properties_t* props, const char* name, const char* description, enum obs_text_type) { return add_property(props, name, description); }
+obs_property_t* obs_properties_add_path(obs_properties_t* props, const char* name, const char* description, enum obs_path_type, const char*, const char*) { return add_property(props, name, description); }
+obs_property_t* obs_properties_add_list(obs_properties_t* props, const char* name, const char* description, enum obs_combo_type, enum obs_combo_format) { return add_property(props, name, description); }
+obs_property_t* obs_properties_add_button(obs_properties_t* props, const char* name, const char* text, obs_property_clicked_t) { return add_property(props, name, text); }
+obs_property_t* obs_properties_add_editable_list(obs_properties_t* props, const char* name, const char* description, int, const char*, const char*) { return add_property(props, name, description); }
+obs_property_t* obs_properties_add_group(obs_properties_t* props, const char* name, const char* description, enum obs_group_type, obs_properties_t* group) {
+	obs_property_t* p = add_property(props, name, description);
+	p->group = group;
+	return p;
+}
+void obs_property_set_visible(obs_property_t* p, bool visible) {
+	if (p) p->visible = visible;
+}
+void obs_property_set_enabled(obs_property_t* p, bool enabled) {
+	if (p) p->enabled = enabled;
+}
+void obs_property_set_description(obs_property_t* p, const char* description) {
+	if (p) p->description = description? description : "";
+}
+void obs_property_set_long_description(obs_property_t*, const char*) {}
+void obs_property_set_modified_callback(obs_property_t*, obs_property_modified_t) {}
+size_t obs_property_list_add_string(obs_property_t* p, const char* name, const char* val) {
+	p->list.emplace_back(name? name : "", val? val : "");
+	return p->list.size() - 1;
+}
+size_t obs_property_list_add_int(obs_property_t* p, const char* name, long long val) {
+	p->list.emplace_back(name? name : "", to_string(val));
+	return p->list.size() - 1;
+}
+void obs_property_list_clear(obs_property_t* p) {
+	if (p) p->list.clear();
+}
+obs_properties_t* obs_property_group_content(obs_property_t* p) { return p? p->group : nullptr; }
+
+// obs-source.h
+struct obs_weak_source {
+	atomic_long refs = 1; // One held by the source itself until it is destroyed.
+	atomic<obs_source_t*> source;
+};
+struct obs_source {
+	atomic_long refs = 1;
+	obs_weak_source_t* weak = new obs_weak_source{1, this};
+	string id, name, uuid;
+	const obs_source_info* info = nullptr;
+	void* context = nullptr;
+	obs_data_t* settings = nullptr;
+	obs_data_t* private_settings = nullptr;
+	float volume = 1.0f, balance = 0.5f;
+	bool muted = false, removed = false, is_private = false;
+	signal_handler_t signals;
+	proc_handler_t procs;
+	mutex audio_capture_lock;
+	vector<pair<obs_source_audio_capture_t, void*>> audio_capture_callbacks;
+	obs_scene_t* scene = nullptr; // Set for sources created by obs_scene_create.
+};
+struct obs_scene_item {
+	int64_t id;
+	obs_scene_t* scene;
+	obs_source_t* source;
+	bool visible = true;
+};
+struct obs_scene {
+	obs_source_t* source;
+	recursive_mutex lock;
+	vector<obs_sceneitem_t*> items; // Bottom to top, the order obs_scene_enum_items uses.
+	int64_t next_id = 1;
+};
+static mutex g_public_sources_lock;
+static vector<obs_source_t*> g_public_sources; // Sources that can be found by name, in creation order.
+static deque<obs_source_info> g_source_types; // A deque so that registering a type never moves the info existing sources point to.
+static atomic<uint64_t> g_audio_frames_output = 0;
+static atomic<uint64_t> g_source_counter = 0;
+void obs_register_source_s(const struct obs_source_info* info, size_t) { g_source_types.push_back(*info); }
+static const obs_source_info* find_source_info(const char* id) {
+	for (const obs_source_info& i : g_source_types) {
+		if (strcmp(i.id, id) == 0) return &i;
+	}
+	return nullptr;
+}
+static obs_source_t* create_source(const char* id, const char* name, obs_data_t* settings, obs_data_t* private_settings, bool is_private, bool is_scene = false) {
+	obs_source_t* src = new obs_source();
+	src->is_private = is_private;
+	if (is_scene) src->scene = new obs_scene{src};
+	src->id = id? id : "";
+	src->name = name? name : "";
+	src->uuid = to_string(++g_source_counter);
+	src->info = find_source_info(src->id.c_str());
+	src->settings = obs_data_create();
+	src->private_settings = obs_data_create();
+	if (src->info && src->info->get_defaults) src->info->get_defaults(src->settings);
+	obs_data_apply(src->settings, settings);
+	obs_data_apply(src->private_settings, private_settings);
+	if (src->info && src->info->create) src->context = src->info->create(src->settings, src);
+	if (src->info && src->info->create && !src->context) blog(LOG_ERROR, "Failed to create source '%s'!", src->name.c_str());
+	if (!is_private) {
+		{
+			lock_guard<mutex> l(g_public_sources_lock);
+			g_public_sources.push_back(src);
+		}
+		calldata_t cd;
+		uint8_t stack[128];
+		calldata_init_fixed(&cd, stack, sizeof(stack));
+		calldata_set_ptr(&cd, "source", src);
+		stub_emit_signal("source_create", &cd);
+	}
+	return src;
+}
+obs_source_t* obs_source_create(const char* id, const char* name, obs_data_t* settings, obs_data_t*) { return create_source(id, name, settings, nullptr, false); }
+obs_source_t* obs_source_create_private(const char* id, const char* name, obs_data_t* settings) { return create_source(id, name, settings, nullptr, true); }
+obs_source_t* obs_load_private_source(obs_data_t* data) {
+	if (!data) return nullptr;
+	obs_data_t* settings = obs_data_get_obj(data, "settings");
+	obs_data_t* private_settings = obs_data_get_obj(data, "private_settings");
+	obs_source_t* src = create_source(obs_data_get_string(data, "id"), obs_data_get_string(data, "name"), settings, private_settings, true);
+	obs_data_release(settings);
+	obs_data_release(private_settings);
+	return src;
+}
+obs_data_t* obs_save_source(obs_source_t* source) {
+	if (!source) return nullptr;
+	obs_data_t* data = obs_data_create();
+	obs_data_t* settings = obs_data_create();
+	obs_data_apply(settings, source->settings);
+	if (source->info && source->info->save && source->context) source->info->save(source->context, settings);
+	obs_data_set_string(data, "id", source->id.c_str());
+	obs_data_set_string(data, "name", source->name.c_str());
+	obs_data_set_string(data, "uuid", source->uuid.c_str());
+	obs_data_set_obj(data, "settings", settings);
+	obs_data_set_obj(data, "private_settings", source->private_settings);
+	obs_data_release(settings);
+	return data;
+}
+obs_source_t* obs_source_get_ref(obs_source_t* source) {
+	if (!source) return nullptr;
+	long refs = source->refs.load();
+	while (refs > 0) {
+		if (source->refs.compare_exchange_weak(refs, refs + 1)) return source;
+	}
+	return nullptr;
+}
+void obs_source_release(obs_source_t* source) {
+	if (!source || --source->refs > 0) return;
+	calldata_t cd;
+	uint8_t stack[128];
+	calldata_init_fixed(&cd, stack, sizeof(stack));
+	calldata_set_ptr(&cd, "source", source);
+	stub_emit_signal("source_destroy", &cd);
+	if (!source->is_private) {
+		lock_guard<mutex> l(g_public_sources_lock);
+		erase(g_public_sources, source);
+	}
+	if (source->scene) {
+		for (obs_sceneitem_t* item : source->scene->items) {
+			obs_source_release(item->source);
+			delete item;
+		}
+		delete source->scene;
+	}
+	if (source->info && source->info->destroy && source->context) source->info->destroy(source->context);
+	obs_data_release(source->settings);
+	obs_data_release(source->private_settings);
+	source->weak->source = nullptr;
+	obs_weak_source_release(source->weak);
+	delete source;
+}
+obs_weak_source_t* obs_source_get_weak_source(obs_source_t* source) {
+	if (!source) return nullptr;
+	source->weak->refs++;
+	return source->weak;
+}
+void obs_weak_source_release(obs_weak_source_t* weak) {
+	if (weak && --weak->refs == 0) delete weak;
+}
+bool obs_weak_source_references_source(obs_weak_source_t* weak, obs_source_t* source) { return weak && source && weak->source == source; }
+void obs_source_remove(obs_source_t* source) {
+	if (source) source->removed = true;
+}
+bool obs_source_removed(const obs_source_t* source) { return source && source->removed; }
+obs_data_t* obs_source_get_settings(const obs_source_t* source) {
+	if (!source) return nullptr;
+	obs_data_addref(source->settings);
+	return source->settings;
+}
+obs_data_t* obs_source_get_private_settings(obs_source_t* item) {
+	if (!item) return nullptr;
+	obs_data_addref(item->private_settings);
+	return item->private_settings;
+}
+void obs_source_update(obs_source_t* source, obs_data_t* settings) {
+	if (!source) return;
+	obs_data_apply(source->settings, settings);
+	if (source->info && source->info->update && source->context) source->info->update(source->context, source->settings);
+}
+const char* obs_source_get_name(const obs_source_t* source) { return source? source->name.c_str() : nullptr; }
+const char* obs_source_get_id(const obs_source_t* source) { return source? source->id.c_str() : nullptr; }
+const char* obs_source_get_uuid(const obs_source_t* source) { return source? source->uuid.c_str() : nullptr; }
+const char* obs_source_get_display_name(const char* id) {
+	const obs_source_info* info = id? find_source_info(id) : nullptr;
+	return info && info->get_name? info->get_name(nullptr) : id;
+}
+enum obs_source_type obs_source_get_type(const obs_source_t* source) { return source && source->info? source->info->type : OBS_SOURCE_TYPE_INPUT; }
+uint32_t obs_source_get_output_flags(const obs_source_t* source) { return source && source->info? source->info->output_flags : 0; }
+float obs_source_get_volume(const obs_source_t* source) { return source? source->volume : 0.0f; }
+void obs_source_set_volume(obs_source_t* source, float volume) {
+	if (!source) return;
+	source->volume = volume;
+	calldata_t cd;
+	uint8_t stack[128];
+	calldata_init_fixed(&cd, stack, sizeof(stack));
+	calldata_set_ptr(&cd, "source", source);
+	calldata_set_float(&cd, "volume", volume);
+	signal_handler_signal(&source->signals, "volume", &cd);
+	stub_emit_signal("source_volume", &cd);
+}
+void obs_source_set_name(obs_source_t* source, const char* name) {
+	if (!source || !name || source->name == name) return;
+	string prev_name = source->name;
+	source->name = name;
+	calldata_t cd;
+	uint8_t stack[256];
+	calldata_init_fixed(&cd, stack, sizeof(stack));
+	calldata_set_ptr(&cd, "source", source);
+	calldata_set_string(&cd, "new_name", name);
+	calldata_set_string(&cd, "prev_name", prev_name.c_str());
+	signal_handler_signal(&source->signals, "rename", &cd);
+	stub_emit_signal("source_rename", &cd);
+}
+float obs_source_get_balance_value(const obs_source_t* source) { return source? source->balance : 0.5f; }
+bool obs_source_muted(const obs_source_t* source) { return source && source->muted; }
+void obs_source_set_muted(obs_source_t* source, bool muted) {
+	if (!source) return;
+	source->muted = muted;
+	calldata_t cd;
+	uint8_t stack[128];
+	calldata_init_fixed(&cd, stack, sizeof(stack));
+	calldata_set_ptr(&cd, "source", source);
+	calldata_set_bool(&cd, "muted", muted);
+	signal_handler_signal(&source->signals, "mute", &cd);
+}
+bool obs_source_showing(const obs_source_t* source) { return source != nullptr; }
+bool obs_source_active(const obs_source_t* source) { return source != nullptr; }
+void obs_source_set_monitoring_type(obs_source_t*, enum obs_monitoring_type) {}
+enum obs_monitoring_type obs_source_get_monitoring_type(const obs_source_t*) { return OBS_MONITORING_TYPE_MONITOR_ONLY; }
+void obs_source_inc_active(obs_source_t*) {}
+void obs_source_dec_active(obs_source_t*) {}
+void obs_source_inc_showing(obs_source_t*) {}
+void obs_source_dec_showing(obs_source_t*) {}
+void obs_source_output_audio(obs_source_t*, const struct obs_source_audio* audio) {
+	if (audio) g_audio_frames_output += audio->frames;
+}
+signal_handler_t* obs_source_get_signal_handler(const obs_source_t* source) { return source? const_cast<signal_handler_t*>(&source->signals) : nullptr; }
+proc_handler_t* obs_source_get_proc_handler(const obs_source_t* source) { return source? const_cast<proc_handler_t*>(&source->procs) : nullptr; }
+obs_source_t* stub_create_source(const char* id, const char* name) { return create_source(id, name, nullptr, nullptr, false); }
+void obs_source_add_audio_capture_callback(obs_source_t* source, obs_source_audio_capture_t callback, void* param) {
+	if (!source) return;
+	lock_guard<mutex> l(source->audio_capture_lock);
+	source->audio_capture_callbacks.emplace_back(callback, param);
+}
+void obs_source_remove_audio_capture_callback(obs_source_t* source, obs_source_audio_capture_t callback, void* param) {
+	if (!source) return;
+	lock_guard<mutex> l(source->audio_capture_lock);
+	erase(source->audio_capture_callbacks, make_pair(callback, param));
+}
+void stub_capture_audio(obs_source_t* source, const struct audio_data* audio, bool muted) {
+	if (!source) return;
+	lock_guard<mutex> l(source->audio_capture_lock);
+	for (auto& [callback, param] : source->audio_capture_callbacks) callback(param, source, audio, muted);
+}
+obs_source_t* obs_get_source_by_name(const char* name) {
+	if (!name) return nullptr;
+	lock_guard<mutex> l(g_public_sources_lock);
+	for (obs_source_t* source : g_public_sources) {
+		if (source->name != name) continue;
+		if (obs_source_t* ref = obs_source_get_ref(source)) return ref;
+	}
+	return nullptr;
+}
+// obs-scene.h, item signals are raised on the scene's own handler the way libobs does.
+static void emit_item_signal(obs_sceneitem_t* item, const char* signal) {
+	calldata_t cd;
+	uint8_t stack[192];
+	calldata_init_fixed(&cd, stack, sizeof(stack));
+	calldata_set_ptr(&cd, "scene", item->scene);
+	calldata_set_ptr(&cd, "item", item);
+	calldata_set_bool(&cd, "visible", item->visible);
+	signal_handler_signal(&item->scene->source->signals, signal, &cd);
+}
+obs_scene_t* obs_scene_create(const char* name) { return create_source("scene", name, nullptr, nullptr, false, true)->scene; }
+void obs_scene_release(obs_scene_t* scene) {
+	if (scene) obs_source_release(scene->source);
+}
+obs_scene_t* obs_scene_from_source(const obs_source_t* source) { return source? source->scene : nullptr; }
+obs_source_t* obs_scene_get_source(const obs_scene_t* scene) { return scene? scene->source : nullptr; }
+void obs_scene_enum_items(obs_scene_t* scene, bool (*callback)(obs_scene_t*, obs_sceneitem_t*, void*), void* param) {
+	if (!scene) return;
+	lock_guard<recursive_mutex> l(scene->lock);
+	for (obs_sceneitem_t* item : scene->items) {
+		if (!callback(scene, item, param)) break;
+	}
+}
+obs_sceneitem_t* obs_scene_add(obs_scene_t* scene, obs_source_t* source) {
+	if (!scene || !source) return nullptr;
+	obs_sceneitem_t* item = new obs_scene_item{scene->next_id++, scene, obs_source_get_ref(source)};
+	{
+		lock_guard<recursive_mutex> l(scene->lock);
+		scene->items.push_back(item);
+	}
+	emit_item_signal(item, "item_add");
+	return item;
+}
+void obs_sceneitem_remove(obs_sceneitem_t* item) {
+	if (!item) return;
+	{
+		lock_guard<recursive_mutex> l(item->scene->lock);
+		erase(item->scene->items, item);
+	}
+	emit_item_signal(item, "item_remove");
+	obs_source_release(item->source);
+	delete item;
+}
+obs_source_t* obs_sceneitem_get_source(const obs_sceneitem_t* item) { return item? item->source : nullptr; }
+obs_scene_t* obs_sceneitem_get_scene(const obs_sceneitem_t* item) { return item? item->scene : nullptr; }
+int64_t obs_sceneitem_get_id(const obs_sceneitem_t* item) { return item? item->id : 0; }
+bool obs_sceneitem_visible(const obs_sceneitem_t* item) { return item && item->visible; }
+bool obs_sceneitem_set_visible(obs_sceneitem_t* item, bool visible) {
+	if (!item || item->visible == visible) return false;
+	item->visible = visible;
+	emit_item_signal(item, "item_visible");
+	return true;
+}
+void obs_enum_scenes(bool (*enum_proc)(void*, obs_source_t*), void* param) {
+	vector<obs_source_t*> scenes;
+	{
+		lock_guard<mutex> l(g_public_sources_lock);
+		for (obs_source_t* source : g_public_sources) {
+			if (source->scene && obs_source_get_ref(source)) scenes.push_back(source);
+		}
+	}
+	bool more = true;
+	for (obs_source_t* source : scenes) {
+		if (more) more = enum_proc(param, source);
+		obs_source_release(source);
+	}
+}
+void obs_enum_sources(bool (*enum_proc)(void*, obs_source_t*), void* param) {
+	vector<obs_source_t*> sources;
+	{
+		lock_guard<mutex> l(g_public_sources_lock);
+		for (obs_source_t* source : g_public_sources) {
+			if (obs_source_get_ref(source)) sources.push_back(source);
+		}
+	}
+	bool more = true;
+	for (obs_source_t* source : sources) {
+		if (more) more = enum_proc(param, source);
+		obs_source_release(source);
+	}
+}
+uint64_t stub_audio_frames_output() { return g_audio_frames_output; }
+
+// obs-hotkey.h, bindings are never saved or loaded, hotkeys can only be pressed through stub_press_hotkey.
+struct obs_hotkey {
+	obs_hotkey_id id;
+	string name;
+	obs_hotkey_func func;
+	void* data;
+};
+static mutex g_hotkeys_lock;
+static map<obs_hotkey_id, obs_hotkey> g_hotkeys;
+static obs_hotkey_id g_next_hotkey_id = 0;
+obs_hotkey_id obs_hotkey_register_frontend(const char* name, const char*, obs_hotkey_func func, void* data) {
+	lock_guard<mutex> l(g_hotkeys_lock);
+	obs_hotkey_id id = g_next_hotkey_id++;
+	g_hotkeys[id] = {id, name? name : "", func, data};
+	return id;
+}
+void obs_hotkey_unregister(obs_hotkey_id id) {
+	lock_guard<mutex> l(g_hotkeys_lock);
+	g_hotkeys.erase(id);
+}
+obs_hotkey_pair_id obs_hotkey_pair_register_frontend(const char*, const char*, const char*, const char*, obs_hotkey_active_func, obs_hotkey_active_func, void*, void*) { return OBS_INVALID_HOTKEY_PAIR_ID; }
+void obs_hotkey_pair_unregister(obs_hotkey_pair_id) {}
+void obs_hotkey_load(obs_hotkey_id, obs_data_array_t*) {}
+void obs_hotkey_pair_load(obs_hotkey_pair_id, obs_data_array_t*, obs_data_array_t*) {}
+obs_data_array_t* obs_hotkey_save(obs_hotkey_id) { return nullptr; }
+const char* obs_hotkey_get_name(const obs_hotkey_t* key) { return key? key->name.c_str() : nullptr; }
+obs_hotkey_id obs_hotkey_get_id(const obs_hotkey_t* key) { return key? key->id : OBS_INVALID_HOTKEY_ID; }
+bool stub_press_hotkey(const char* name) {
+	obs_hotkey hotkey;
+	{
+		lock_guard<mutex> l(g_hotkeys_lock);
+		auto it = find_if(g_hotkeys.begin(), g_hotkeys.end(), [&](auto& i) { return i.second.name == name; });
+		if (it == g_hotkeys.end()) return false;
+		hotkey = it->second;
+	}
+	hotkey.func(hotkey.data, hotkey.id, &hotkey, true);
+	hotkey.func(hotkey.data, hotkey.id, &hotkey, false);
+	return true;
+}
+
+// Health counters and outputs, driven by stub_set_load and stub_set_output so that the load monitor has something to watch.
+static atomic<double> g_cpu_usage = 0.0;
+static atomic<uint32_t> g_total_frames = 0, g_lagged_frames = 0, g_skipped_frames = 0;
+struct os_cpu_usage_info {
+	int unused;
+};
+os_cpu_usage_info_t* os_cpu_usage_info_start(void) { return new os_cpu_usage_info(); }
+double os_cpu_usage_info_query(os_cpu_usage_info_t* info) { return info? g_cpu_usage.load() : 0.0; }
+void os_cpu_usage_info_destroy(os_cpu_usage_info_t* info) { delete info; }
+uint64_t os_get_proc_resident_size(void) { return 0; }
+uint32_t obs_get_total_frames(void) { return g_total_frames; }
+uint32_t obs_get_lagged_frames(void) { return g_lagged_frames; }
+double obs_get_active_fps(void) { return 60.0; }
+uint64_t obs_get_average_frame_time_ns(void) { return 2000000; }
+struct video_output {
+	int unused;
+};
+static video_t g_video;
+video_t* obs_get_video(void) { return &g_video; }
+struct raw_video_callback {
+	void (*callback)(void* param, struct video_data* frame);
+	void* param;
+	uint32_t divisor;
+};
+static mutex g_raw_video_lock;
+static vector<raw_video_callback> g_raw_video_callbacks;
+static uint64_t g_raw_video_frames = 0;
+void obs_add_raw_video_callback(const struct video_scale_info* conversion, void (*callback)(void* param, struct video_data* frame), void* param) { obs_add_raw_video_callback2(conversion, 1, callback, param); }
+void obs_add_raw_video_callback2(const struct video_scale_info*, uint32_t frame_rate_divisor, void (*callback)(void* param, struct video_data* frame), void* param) {
+	lock_guard<mutex> l(g_raw_video_lock);
+	g_raw_video_callbacks.push_back({callback, param, frame_rate_divisor? frame_rate_divisor : 1});
+}
+void obs_remove_raw_video_callback(void (*callback)(void* param, struct video_data* frame), void* param) {
+	lock_guard<mutex> l(g_raw_video_lock);
+	erase_if(g_raw_video_callbacks, [&](const raw_video_callback& c) { return c.callback == callback && c.param == param; });
+}
+void stub_output_video(struct video_data* frame) {
+	lock_guard<mutex> l(g_raw_video_lock);
+	for (const raw_video_callback& c : g_raw_video_callbacks) {
+		if (g_raw_video_frames % c.divisor == 0) c.callback(c.param, frame);
+	}
+	g_raw_video_frames++;
+}
+size_t stub_raw_video_callback_count() {
+	lock_guard<mutex> l(g_raw_video_lock);
+	return g_raw_video_callbacks.size();
+}
+struct audio_output {};
+static audio_t g_audio;
+audio_t* obs_get_audio(void) { return &g_audio; }
+uint32_t audio_output_get_sample_rate(const audio_t*) { return 48000; }
+size_t audio_output_get_channels(const audio_t*) { return 2; }
+uint32_t video_output_get_skipped_frames(const video_t*) { return g_skipped_frames; }
+uint32_t video_output_get_total_frames(const video_t*) { return g_total_frames; }
+void stub_set_load(double cpu_percent, uint32_t frames, uint32_t lagged, uint32_t skipped) {
+	g_cpu_usage = cpu_percent;
+	g_total_frames += frames;
+	g_lagged_frames += lagged;
+	g_skipped_frames += skipped;
+}
+struct obs_output {
+	bool active;
+	int total_frames;
+	int dropped_frames;
+	uint64_t total_bytes;
+	float congestion;
+	bool reconnecting;
+};
+static obs_output g_stub_outputs[2]; // Streaming and recording, never freed.
+static mutex g_stub_outputs_lock;
+obs_output_t* stub_get_output(bool streaming) { return &g_stub_outputs[streaming? 0 : 1]; }
+void stub_set_output(bool streaming, bool active, int total_frames, int dropped_frames, uint64_t total_bytes, float congestion, bool reconnecting) {
+	lock_guard<mutex> l(g_stub_outputs_lock);
+	g_stub_outputs[streaming? 0 : 1] = {active, total_frames, dropped_frames, total_bytes, congestion, reconnecting};
+}
+struct obs_weak_output {
+	obs_output_t* output;
+};
+static obs_weak_output g_stub_weak_outputs[2] = {{&g_stub_outputs[0]}, {&g_stub_outputs[1]}};
+obs_output_t* obs_output_get_ref(obs_output_t* output) { return output; }
+void obs_output_release(obs_output_t*) {}
+obs_weak_output_t* obs_output_get_weak_output(obs_output_t* output) { return output? &g_stub_weak_outputs[output - g_stub_outputs] : nullptr; }
+obs_output_t* obs_weak_output_get_output(obs_weak_output_t* weak) { return weak? weak->output : nullptr; }
+void obs_weak_output_release(obs_weak_output_t*) {}
+bool obs_output_active(const obs_output_t* output) {
+	lock_guard<mutex> l(g_stub_outputs_lock);
+	return output && output->active;
+}
+uint64_t obs_output_get_total_bytes(const obs_output_t* output) {
+	lock_guard<mutex> l(g_stub_outputs_lock);
+	return output? output->total_bytes : 0;
+}
+int obs_output_get_frames_dropped(const obs_output_t* output) {
+	lock_guard<mutex> l(g_stub_outputs_lock);
+	return output? output->dropped_frames : 0;
+}
+int obs_output_get_total_frames(const obs_output_t* output) {
+	lock_guard<mutex> l(g_stub_outputs_lock);
+	return output? output->total_frames : 0;
+}
+float obs_output_get_congestion(obs_output_t* output) {
+	lock_guard<mutex> l(g_stub_outputs_lock);
+	return output? output->congestion : 0.0f;
+}
+bool obs_output_reconnecting(const obs_output_t* output) {
+	lock_guard<mutex> l(g_stub_outputs_lock);
+	return output && output->reconnecting;
+}
+
+// obs-module.h
+static string g_data_dir, g_config_dir;
+static unordered_map<string, string> g_locale;
+static once_flag g_locale_loaded;
+void stub_set_paths(const char* data_dir, const char* config_dir) {
+	g_data_dir = data_dir? data_dir : "";
+	g_config_dir = config_dir? config_dir : "";
+}
+static void load_locale() {
+	ifstream f(filesystem::path(g_data_dir) / "locale" / "en-US.ini");
+	string line;
+	while (getline(f, line)) {
+		size_t eq = line.find('=');
+		if (eq == string::npos) continue;
+		string value = line.substr(eq + 1);
+		if (!value.empty() && value.back() == '\r') value.pop_back();
+		if (value.size() >= 2 && value.front() == '"' && value.back() == '"') value = value.substr(1, value.size() - 2);
+		g_locale[line.substr(0, eq)] = value;
+	}
+}
+obs_module_t* obs_current_module(void) { return nullptr; }
+const char* obs_get_module_binary_path(obs_module_t*) { return ""; }
+bool obs_module_get_string(const char* lookup_string, const char** translated_string) {
+	call_once(g_locale_loaded, load_locale);
+	auto it = g_locale.find(lookup_string);
+	if (it == g_locale.end()) return false;
+	*translated_string = it->second.c_str();
+	return true;
+}
+const char* obs_module_text(const char* lookup_string) {
+	const char* out = lookup_string;
+	obs_module_get_string(lookup_string, &out);
+	return out;
+}
+char* obs_module_file(const char* file) {
+	filesystem::path path = filesystem::path(g_data_dir) / file;
+	if (!os_file_exists(path.string().c_str())) return nullptr;
+	return bstrdup(path.string().c_str());
+}
+char* obs_module_config_path(const char* file) {
+	filesystem::path path = g_config_dir;
+	if (file) path /= file;
+	return bstrdup(path.string().c_str());
+}
@@ -0,0 +1,68 @@
+/*
+ OBS Accessibility
+ Copyright (C) 2025 Sam Tupy Productions <webmaster@samtupy.com>
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along
+ with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+// In-process implementation of the prism subset declared in include/prism.h. The single registered backend never makes a sound, it only counts and remembers what it was asked to speak.
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <prism.h>
+#include <obs-stub.h>
+
+using namespace std;
+
+struct PrismContext {
+	int unused;
+};
+struct PrismBackend {
+	bool initialized;
+};
+static atomic<uint64_t> g_utterances = 0;
+static mutex g_last_utterance_lock;
+static char g_last_utterance[1024];
+PrismContext* prism_init(PrismConfig*) { return new PrismContext(); }
+void prism_shutdown(PrismContext* ctx) { delete ctx; }
+size_t prism_registry_count(PrismContext* ctx) { return ctx? 1 : 0; }
+PrismBackendId prism_registry_id_at(PrismContext* ctx, size_t index) { return ctx && index == 0? 1 : 0; }
+const char* prism_registry_name(PrismContext* ctx, PrismBackendId id) { return ctx && id == 1? "Stub" : nullptr; }
+PrismBackend* prism_registry_create(PrismContext* ctx, PrismBackendId id) { return ctx && id == 1? new PrismBackend() : nullptr; }
+PrismBackend* prism_registry_acquire_best(PrismContext* ctx) {
+	PrismBackend* backend = prism_registry_create(ctx, 1);
+	if (backend) backend->initialized = true;
+	return backend;
+}
+void prism_backend_free(PrismBackend* backend) { delete backend; }
+const char* prism_backend_name(PrismBackend* backend) { return backend? "Stub" : nullptr; }
+PrismError prism_backend_initialize(PrismBackend* backend) {
+	if (!backend) return PRISM_ERROR_INVALID_PARAM;
+	if (backend->initialized) return PRISM_ERROR_ALREADY_INITIALIZED;
+	backend->initialized = true;
+	return PRISM_OK;
+}
+PrismError prism_backend_speak(PrismBackend* backend, const char* text, bool) {
+	if (!backend || !text) return PRISM_ERROR_INVALID_PARAM;
+	if (!backend->initialized) return PRISM_ERROR_NOT_INITIALIZED;
+	{
+		lock_guard<mutex> l(g_last_utterance_lock);
+		strncpy(g_last_utterance, text, sizeof(g_last_utterance) - 1);
+	}
+	g_utterances++;
+	return PRISM_OK;
+}
+PrismError prism_backend_stop(PrismBackend* backend) { return backend? PRISM_OK : PRISM_ERROR_INVALID_PARAM; }
+uint64_t stub_utterance_count() { return g_utterances; }
+const char* stub_last_utterance() { return g_last_utterance; }
@@ -0,0 +1,163 @@
+/*
+ OBS Accessibility
+ Copyright (C) 2025 Sam Tupy Productions <webmaster@samtupy.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along
+ with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <obs.h>
+#include <util/platform.h>
+#include "api.h"
+#include "audio.h"
+#include "dispatch.h"
+#include "monitor.h"
+
+using namespace std;
+
+struct recent_message {
+	uint64_t hash;
+	uint64_t time; // os_gettime_ns() it was queued.
+};
+mutex g_api_lock; // Guards the list of recent messages.
+recent_message g_api_recent[API_RECENT_MESSAGES] = {};
+size_t g_api_recent_next = 0;
+atomic<uint64_t> g_api_repeats = 0;
+atomic<bool> g_api_live = false;
+bool g_api_registered = false;
+
+static size_t cut_message(char* out, string_view message) {
+	size_t length = message.size();
+	if (length >= API_MESSAGE_SIZE) {
+		length = API_MESSAGE_SIZE - 1;
+		size_t space = message.substr(0, length).find_last_of(" \t\n");
+		if (space != string_view::npos && space > 0) length = space;
+		else while (length && (message[length] & 0xc0) == 0x80) length--; // Never split a UTF-8 sequence.
+	}
+	memcpy(out, message.data(), length);
+	out[length] = '\0';
+	return length;
+}
+static bool announce_message_locked(event_type* event, string_view message, uint64_t now) {
+	// Call with g_api_lock held.
+	if (event->is_low_priority() && is_shedding_load()) {
+		count_shed_event();
+		return false;
+	}
+	char text[API_MESSAGE_SIZE];
+	size_t length = cut_message(text, message);
+	uint64_t hash = 14695981039346656037ULL ^ event->get_index(); // FNV-1a, seeded with the event so that the same words for different events are both heard.
+	for (size_t i = 0; i < length; i++) hash = (hash ^ uint8_t(text[i])) * 1099511628211ULL;
+	for (const recent_message& recent : g_api_recent) {
+		if (recent.hash == hash && recent.time && now - recent.time < API_REPEAT_MS * 1000000ULL) {
+			g_api_repeats++;
+			return false;
+		}
+	}
+	uint8_t stack[DISPATCH_CALLDATA_SIZE];
+	calldata_t data;
+	calldata_init_fixed(&data, stack, sizeof(stack));
+	calldata_set_string(&data, "message", text);
+	if (!dispatch_event(event, &data)) return false;
+	g_api_recent[g_api_recent_next++ % API_RECENT_MESSAGES] = {hash, now};
+	return true;
+}
+bool announce_message(event_type* event, string_view message) {
+	if (!g_api_live.load(memory_order_acquire) || !event || !event->is_active() || message.empty()) return false;
+	uint64_t now = os_gettime_ns();
+	lock_guard<mutex> lock(g_api_lock);
+	return announce_message_locked(event, message, now);
+}
+size_t announce_messages(event_type* event, string_view messages) {
+	if (!g_api_live.load(memory_order_acquire) || !event || !event->is_active()) return 0;
+	uint64_t now = os_gettime_ns();
+	size_t queued = 0;
+	lock_guard<mutex> lock(g_api_lock);
+	while (!messages.empty()) {
+		size_t end = messages.find('\n');
+		string_view line = messages.substr(0, end);
+		messages.remove_prefix(end == string_view::npos? messages.size() : end + 1);
+		if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+		if (!line.empty()) queued += announce_message_locked(event, line, now);
+	}
+	return queued;
+}
+uint64_t get_api_repeat_count() { return g_api_repeats.load(); }
+
+static event_type* get_api_event(const calldata_t* data) {
+	// Announcements use the generic script event unless the caller names another, usually one it registered for itself.
+	const char* id = calldata_string(data, "event");
+	return get_event_type(std::string_view(id && *id? id : "script_announcement"));
+}
+static void proc_announce(void*, calldata_t* data) {
+	const char* message = calldata_string(data, "message");
+	bool queued = g_api_live.load(memory_order_acquire) && message && announce_message(get_api_event(data), message);
+	calldata_set_bool(data, "queued", queued);
+}
+static void proc_announce_batch(void*, calldata_t* data) {
+	const char* messages = calldata_string(data, "messages");
+	size_t queued = g_api_live.load(memory_order_acquire) && messages? announce_messages(get_api_event(data), messages) : 0;
+	calldata_set_int(data, "queued", (long long)queued);
+}
+static void proc_play(void*, calldata_t* data) {
+	const char* id = calldata_string(data, "event");
+	event_type* event = g_api_live.load(memory_order_acquire) && id? get_event_type(std::string_view(id)) : nullptr;
+	bool played = false;
+	if (event && event->is_low_priority() && is_shedding_load()) count_shed_event();
+	else if (event) played = dispatch_event(event, nullptr, false, true); // Mixing is left to the dispatch thread, so the script never waits on the audio locks.
+	calldata_set_bool(data, "played", played);
+}
+static void refresh_custom_event(void*) { refresh_event_cache(); }
+static void proc_register_event(void*, calldata_t* data) {
+	const char* id = calldata_string(data, "id");
+	const char* name = calldata_string(data, "name");
+	const char* description = calldata_string(data, "description");
+	const char* message = calldata_string(data, "message");
+	size_t count = get_event_type_count();
+	event_type* event = id? register_custom_event_type(id, name? name : "", description? description : "", message? message : "") : nullptr;
+	// Earcons, tones and whether the new event has anything to announce are worked out with everything else, on the UI thread where settings changes do it.
+	if (event && get_event_type_count() != count) obs_queue_task(OBS_TASK_UI, refresh_custom_event, nullptr, false);
+	calldata_set_bool(data, "registered", event != nullptr);
+}
+static void proc_stats(void*, calldata_t* data) {
+	dispatch_stats stats = get_dispatch_stats();
+	calldata_set_int(data, "dispatched", (long long)stats.dispatched);
+	calldata_set_int(data, "dropped", (long long)stats.dropped);
+	calldata_set_int(data, "filtered", (long long)stats.filtered);
+	calldata_set_int(data, "pending", (long long)stats.pending);
+	calldata_set_int(data, "shed", (long long)get_shed_event_count());
+	calldata_set_int(data, "repeats", (long long)get_api_repeat_count());
+}
+
+void init_api() {
+	if (g_api_registered) return;
+	proc_handler_t* handler = obs_get_proc_handler();
+	if (!handler) return;
+	proc_handler_add(handler, "void accessibility_announce(in string message, in string event, out bool queued)", proc_announce, nullptr);
+	proc_handler_add(handler, "void accessibility_announce_batch(in string messages, in string event, out int queued)", proc_announce_batch, nullptr);
+	proc_handler_add(handler, "void accessibility_play(in string event, out bool played)", proc_play, nullptr);
+	proc_handler_add(handler, "void accessibility_register_event(in string id, in string name, in string description, in string message, out bool registered)", proc_register_event, nullptr);
+	proc_handler_add(handler, "void accessibility_stats(out int dispatched, out int dropped, out int filtered, out int pending, out int shed, out int repeats)", proc_stats, nullptr);
+	g_api_registered = true;
+}
+void start_api_announcements() {
+	g_api_live.store(true, memory_order_release);
+}
+void stop_api_announcements() {
+	g_api_live.store(false, memory_order_release);
+	lock_guard<mutex> lock(g_api_lock);
+	for (recent_message& recent : g_api_recent) recent = {};
+}
@@ -0,0 +1,35 @@
+/*
+ OBS Accessibility
+ Copyright (C) 2025 Sam Tupy Productions <webmaster@samtupy.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along
+ with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include "events.h"
+
+#define API_MESSAGE_SIZE 400 // Bytes of each announced message, longer ones are cut at the last word that fits so that they still travel in a dispatch job.
+#define API_REPEAT_MS 1000 // The same message for the same event again within this long is dropped as a repeat.
+#define API_RECENT_MESSAGES 32 // Messages remembered for spotting repeats.
+
+// Procedures on the global proc handler that let scripts and other plugins announce through this plugin instead of bringing their own speech, see the README for their declarations. Everything they announce goes through the dispatch queue, load shedding and event rules like any OBS event.
+void init_api(); // Call after the event types are registered. OBS has no way to remove a procedure, so they stay registered and answer false once stopped.
+void start_api_announcements(); // Calls before this, while OBS is loading, are refused.
+void stop_api_announcements();
+bool announce_message(event_type* event, std::string_view message); // Queues message as event's message variable. False if it was dropped.
+size_t announce_messages(event_type* event, std::string_view messages); // One message per line under a single lock, returns how many were queued.
+uint64_t get_api_repeat_count();
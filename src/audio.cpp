@@ -17,34 +17,104 @@
 */
 
 #define MINIAUDIO_IMPLEMENTATION
-#define MA_ENABLE_ONLY_SPECIFIC_BACKENDS //MA_NO_DEVICE is broken right now
+#define MA_ENABLE_ONLY_SPECIFIC_BACKENDS // Only what direct output needs, MA_NO_DEVICE is broken right now.
+#define MA_ENABLE_NULL
+#if defined(_WIN32)
+	#define MA_ENABLE_WASAPI
+#elif defined(__APPLE__)
+	#define MA_ENABLE_COREAUDIO
+#else
+	#define MA_ENABLE_PULSEAUDIO
+	#define MA_ENABLE_ALSA
+#endif
 #define MA_NO_ENCODING
 #include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
 #include <filesystem>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 #include <obs.h>
 #include <obs-module.h>
 #include <obs-source.h>
 #include "audio.h"
 #include "config.h"
+#include "dispatch.h"
+#include "obs-accessibility.h"
+#include "rules.h"
+#include "text.h"
 
 using namespace std;
 
 const char* g_audio_extensions[] = {".wav", ".flac", ".ogg", ".mp3", nullptr};
 vector<event_source_data*> g_audio_event_sources;
+mutex g_audio_event_sources_lock; // The dispatch thread walks the list while sources come and go on the UI thread.
 event_source_data* g_audio_event_source = nullptr; // We specifically manage a hidden, global source.
+atomic<uint64_t> g_earcon_latency_ns = 0;
+// One resource manager is shared by every engine so that an earcon is decoded once no matter how many event sources play it.
+mutex g_resource_manager_lock;
+unique_ptr<ma_resource_manager> g_resource_manager;
+size_t g_resource_manager_users = 0;
+mutex g_preloaded_earcons_lock;
+vector<string> g_preloaded_earcons; // Sorted paths registered with the resource manager by preload_earcons(), forgotten along with it.
+struct earcon_policy {
+	filesystem::file_time_type modified;
+	uintmax_t size;
+	bool stream;
+	uint64_t frames;
+};
+mutex g_earcon_policy_lock;
+unordered_map<string, earcon_policy> g_earcon_policies;
+// The playback device the global source renders into while direct output is on.
+mutex g_direct_output_lock;
+unique_ptr<ma_context> g_direct_context;
+unique_ptr<ma_device> g_direct_device;
+event_source_data* g_direct_source = nullptr;
+int g_direct_period_ms = 0;
+bool g_direct_null_backend = false;
+atomic<uint64_t> g_dispatch_due_frame = 0; // Global source frame the dispatch thread is waiting for, 0 when it waits for none.
+static void event_source_render(event_source_data* d, float* buffer, ma_uint64 frames) {
+	// Everything an event source hears passes through here, whether it is being fed to OBS in real time or rendered offline.
+	ma_uint64 frames_read = 0;
+	uint64_t block_frame = ma_engine_get_time_in_pcm_frames(&*d->engine);
+	ma_engine_read_pcm_frames(&*d->engine, buffer, frames, &frames_read);
+	if (frames_read < frames) memset(buffer + frames_read * 2, 0, (frames - frames_read) * 2 * sizeof(float));
+	render_tones(&d->tones, buffer, uint32_t(frames), block_frame);
+}
+static void event_source_render_block(event_source_data* d, float* buffer, uint32_t frames, uint64_t time) {
+	// Publishes the clock for the block about to be mixed, then mixes it. Call with render_lock held, which keeps the clock to one writer.
+	uint64_t sequence = d->clock_sequence.load(memory_order_relaxed);
+	d->clock_sequence.store(sequence + 1, memory_order_relaxed);
+	atomic_thread_fence(memory_order_release);
+	d->clock_frame.store(ma_engine_get_time_in_pcm_frames(&*d->engine), memory_order_relaxed);
+	d->clock_time.store(time, memory_order_relaxed);
+	d->clock_block.store(frames, memory_order_relaxed);
+	d->clock_sequence.store(sequence + 2, memory_order_release);
+	uint64_t frame = d->clock_frame.load(memory_order_relaxed);
+	event_source_render(d, buffer, frames);
+	uint64_t due = g_dispatch_due_frame.load(memory_order_relaxed);
+	if (due && due < frame + frames && d->global_events && g_dispatch_due_frame.compare_exchange_strong(due, 0, memory_order_relaxed)) wake_dispatch();
+}
 static void* event_source_thread(void* user) {
 	event_source_data* d = (event_source_data*)user;
 	uint64_t ts = 0;
 	uint64_t last_time = os_gettime_ns();
-	float buffer[960];
+	float buffer[EVENT_SOURCE_BLOCK_FRAMES * 2];
 	while (os_event_try(d->event) == EAGAIN) {
 		if (!os_sleepto_ns(last_time += 10000000)) last_time = os_gettime_ns();
-		ma_uint64 frames_read;
-		ma_engine_read_pcm_frames(&*d->engine, &buffer, 480, &frames_read);
+		if (d->direct.load(memory_order_acquire)) {
+			ts += 10000000; // Keeps OBS's timestamps continuous for when direct output is turned off again.
+			continue;
+		}
+		{
+			lock_guard<mutex> lock(d->render_lock);
+			event_source_render_block(d, buffer, EVENT_SOURCE_BLOCK_FRAMES, last_time);
+		}
 		struct obs_source_audio data;
 		data.data[0] = (uint8_t*)buffer;
-		data.frames = 480;
+		data.frames = EVENT_SOURCE_BLOCK_FRAMES;
 		data.speakers = SPEAKERS_STEREO;
 		data.samples_per_sec = 48000;
 		data.timestamp = ts;
@@ -54,6 +124,189 @@ static void* event_source_thread(void* user) {
 	}
 	return nullptr;
 }
+static ma_resource_manager* acquire_resource_manager() {
+	lock_guard<mutex> lock(g_resource_manager_lock);
+	if (!g_resource_manager) {
+		ma_resource_manager_config cfg = ma_resource_manager_config_init();
+		cfg.decodedFormat = ma_format_f32; // Decoded once into the engine's own format, so mixing never converts.
+		cfg.decodedChannels = 2;
+		cfg.decodedSampleRate = 48000;
+		g_resource_manager = make_unique<ma_resource_manager>();
+		if (ma_resource_manager_init(&cfg, &*g_resource_manager) != MA_SUCCESS) {
+			g_resource_manager.reset();
+			return nullptr;
+		}
+	}
+	g_resource_manager_users++;
+	return &*g_resource_manager;
+}
+static void release_resource_manager() {
+	lock_guard<mutex> lock(g_resource_manager_lock);
+	if (!g_resource_manager || --g_resource_manager_users) return;
+	ma_resource_manager_uninit(&*g_resource_manager);
+	g_resource_manager.reset();
+	lock_guard<mutex> preloaded_lock(g_preloaded_earcons_lock);
+	g_preloaded_earcons.clear();
+}
+static bool event_source_init_engine(event_source_data* d) {
+	ma_resource_manager* resources = acquire_resource_manager();
+	if (!resources) return false;
+	ma_engine_config cfg = ma_engine_config_init();
+	cfg.noDevice   = MA_TRUE;
+	cfg.channels   = 2;
+	cfg.sampleRate = 48000;
+	cfg.pResourceManager = resources;
+	d->engine = make_unique<ma_engine>();
+	if (ma_engine_init(&cfg, &*d->engine) != MA_SUCCESS) {
+		d->engine.reset();
+		release_resource_manager();
+		return false;
+	}
+	d->voices = make_unique<event_voice[]>(EVENT_SOURCE_MAX_VOICES);
+	return true;
+}
+static void event_source_uninit_engine(event_source_data* d) {
+	if (!d->engine) return;
+	for (size_t i = 0; d->voices && i < EVENT_SOURCE_MAX_VOICES; i++) {
+		if (d->voices[i].initialized) ma_sound_uninit(&d->voices[i].sound);
+	}
+	d->voices.reset();
+	ma_engine_uninit(&*d->engine);
+	d->engine.reset();
+	release_resource_manager();
+}
+static event_voice* event_source_get_voice(event_source_data* d) {
+	// Reuses a voice that has finished playing when possible, otherwise steals the one started longest ago so that the newest earcon is always heard. Call with voice_lock held.
+	event_voice* oldest = nullptr;
+	for (size_t i = 0; i < EVENT_SOURCE_MAX_VOICES; i++) {
+		event_voice& v = d->voices[i];
+		if (!v.initialized) return &v;
+		if (ma_sound_at_end(&v.sound)) {
+			oldest = &v;
+			break;
+		}
+		if (!oldest || v.serial < oldest->serial) oldest = &v;
+	}
+	ma_sound_uninit(&oldest->sound);
+	oldest->initialized = false;
+	return oldest;
+}
+static void event_source_read_clock(event_source_data* d, uint64_t& frame, uint64_t& time, uint32_t& block) {
+	// time stays 0 until the mixer has started.
+	uint64_t sequence;
+	do {
+		sequence = d->clock_sequence.load(memory_order_acquire);
+		frame = d->clock_frame.load(memory_order_relaxed);
+		time = d->clock_time.load(memory_order_relaxed);
+		block = d->clock_block.load(memory_order_relaxed);
+		atomic_thread_fence(memory_order_acquire);
+	} while ((sequence & 1) || sequence != d->clock_sequence.load(memory_order_relaxed));
+}
+static uint64_t event_source_start_frame(event_source_data* d, uint64_t timestamp) {
+	// Maps the time an event arrived plus the latency target onto the engine's frame clock, or returns 0 to start at the next block.
+	uint64_t latency = g_earcon_latency_ns.load(memory_order_relaxed);
+	if (!latency || !timestamp || d->offline) return 0;
+	uint64_t frame, time;
+	uint32_t block;
+	event_source_read_clock(d, frame, time, block);
+	if (!time) return 0; // The mixer hasn't started yet.
+	int64_t offset = (int64_t(timestamp + latency) - int64_t(time)) * 48000 / 1000000000;
+	if (offset < int64_t(block)) {
+		// That frame is in the block being mixed or one already handed to OBS.
+		d->late_voices.fetch_add(1, memory_order_relaxed);
+		return 0;
+	}
+	return frame + offset;
+}
+static void event_source_extend_end_frame(event_source_data* d, uint64_t start_frame, uint64_t length, uint64_t* end_frame) {
+	// Pushes end_frame out to where a sound of length frames started at start_frame finishes, unless either is unknown.
+	if (!end_frame || !length) return;
+	if (!start_frame) {
+		uint64_t frame, time;
+		uint32_t block;
+		event_source_read_clock(d, frame, time, block);
+		if (!time) return;
+		start_frame = frame + block;
+	}
+	*end_frame = max(*end_frame, start_frame + length);
+}
+static bool event_source_start_voice(event_source_data* d, const char* path, float volume, uint64_t start_frame = 0, bool stream = false) {
+	// Live sources load asynchronously so that the dispatch thread never waits on decoding, offline renders decode up front so their output is deterministic. Call with voice_lock held.
+	ma_uint32 flags = MA_SOUND_FLAG_NO_PITCH | MA_SOUND_FLAG_NO_SPATIALIZATION;
+	flags |= stream && !d->offline? MA_SOUND_FLAG_STREAM : MA_SOUND_FLAG_DECODE;
+	if (!d->offline) flags |= MA_SOUND_FLAG_ASYNC;
+	event_voice* v = event_source_get_voice(d);
+	if (ma_sound_init_from_file(&*d->engine, path, flags, nullptr, nullptr, &v->sound) != MA_SUCCESS) return false;
+	v->initialized = true;
+	v->serial = d->voice_serial++;
+	ma_sound_set_volume(&v->sound, volume);
+	if (start_frame) ma_sound_set_start_time_in_pcm_frames(&v->sound, start_frame); // The engine starts it partway through whichever block contains that frame.
+	return ma_sound_start(&v->sound) == MA_SUCCESS;
+}
+static bool event_source_play_file(event_source_data* d, const string& path, float volume = 1.0f, uint64_t start_frame = 0) {
+	lock_guard<mutex> lock(d->voice_lock);
+	return event_source_start_voice(d, path.c_str(), volume, start_frame);
+}
+static bool event_source_play_earcon(event_source_data* d, size_t event_index, uint64_t timestamp, uint64_t* end_frame) {
+	lock_guard<mutex> lock(d->voice_lock);
+	if (event_index >= d->earcons.size() || d->earcons[event_index].path.empty()) return false;
+	const earcon_file& earcon = d->earcons[event_index];
+	uint64_t start_frame = event_source_start_frame(d, timestamp);
+	if (!event_source_start_voice(d, earcon.path.c_str(), 1.0f, start_frame, earcon.stream)) return false;
+	event_source_extend_end_frame(d, start_frame, earcon.frames, end_frame);
+	return true;
+}
+static bool event_source_play_tone(event_source_data* d, size_t event_index, uint64_t timestamp, const calldata_t* data, string& rendered_template, string& rendered, uint64_t* end_frame) {
+	// Every source configured with the same template shares one rendering of it, the caller keeps the last one.
+	lock_guard<mutex> lock(d->voice_lock);
+	if (event_index >= d->tone_specs.size() || d->tone_specs[event_index].mode == TONE_OFF) return false;
+	const tone_spec& spec = d->tone_specs[event_index];
+	if (spec.value != rendered_template) {
+		rendered_template = spec.value;
+		rendered = replace_obs_variables(spec.value, data);
+	}
+	float position;
+	if (!tone_position(spec, rendered, position)) return false;
+	uint64_t start_frame = event_source_start_frame(d, timestamp);
+	if (!trigger_tone(&d->tones, spec, position, start_frame)) return false;
+	event_source_extend_end_frame(d, start_frame, TONE_MS * 48, end_frame);
+	return true;
+}
+static string get_default_earcon_path() {
+	char* tmp = obs_module_file("earcon");
+	if (!tmp) return "";
+	string path = tmp;
+	bfree(tmp);
+	return path;
+}
+static string find_earcon(const string& config_path, const string& earcon) {
+	for (const char** extension = g_audio_extensions; *extension; ++extension) {
+		filesystem::path path = filesystem::path(config_path) / string(earcon + *extension);
+		if (filesystem::is_regular_file(path)) return path.string();
+	}
+	return "";
+}
+static void event_source_refresh_earcons(event_source_data* d) {
+	// Resolving earcon files touches the filesystem, so it happens once per settings change rather than on every event.
+	vector<earcon_file> earcons(get_event_type_count());
+	vector<tone_spec> tone_specs(earcons.size());
+	if (get_property_bool("sound", d->source)) {
+		string config_path = get_property_string("earcon_path");
+		if (config_path.empty()) config_path = get_default_earcon_path();
+		for (size_t i = 0; i < earcons.size(); i++) {
+			event_type* event = get_event_type(i);
+			if (event->get_muted(d->source)) continue;
+			string tone = event->get_tone(d->source);
+			if (!parse_tone_spec(tone, tone_specs[i])) obs_log(LOG_WARNING, "ignoring value tone \"%s\" for %s", tone.c_str(), event->get_id().c_str());
+			if (config_path.empty()) continue;
+			earcons[i].path = find_earcon(config_path, event->get_id());
+			earcons[i].stream = !earcons[i].path.empty() && should_stream_earcon(earcons[i].path, &earcons[i].frames);
+		}
+	}
+	lock_guard<mutex> lock(d->voice_lock);
+	d->earcons.swap(earcons);
+	d->tone_specs.swap(tone_specs);
+}
 static const char* event_source_getname(void *unused) {
 	UNUSED_PARAMETER(unused);
 	return "Accessibility Audio Events";
@@ -61,35 +314,36 @@ static const char* event_source_getname(void *unused) {
 static void event_source_destroy(void* data) {
 	event_source_data* d = (event_source_data*)data;
 	if (!d) return;
+	{
+		lock_guard<mutex> lock(g_audio_event_sources_lock);
+		auto it = find(g_audio_event_sources.begin(), g_audio_event_sources.end(), d);
+		if (it != g_audio_event_sources.end()) g_audio_event_sources.erase(it);
+	}
 	if (d->initialized_thread) {
 		void *ret;
 		os_event_signal(d->event);
 		pthread_join(d->thread, &ret);
 	}
 	if (d->event) os_event_destroy(d->event);
-	if (d->engine) ma_engine_uninit(&*d->engine);
-	auto it = find(g_audio_event_sources.begin(), g_audio_event_sources.end(), d);
-	if (it != g_audio_event_sources.end()) g_audio_event_sources.erase(it);
+	event_source_uninit_engine(d);
+	bool registered = d->source != nullptr;
 	delete d;
+	if (registered) refresh_event_cache();
 }
 static void* event_source_create(obs_data_t* settings, obs_source_t* source) {
 	event_source_data* d = new event_source_data();
-	ma_engine_config cfg = ma_engine_config_init();
-	cfg.noDevice   = MA_TRUE;
-	cfg.channels   = 2;
-	cfg.sampleRate = 48000;
-	d->engine = make_unique<ma_engine>();
-	if (ma_engine_init(&cfg, &*d->engine) != MA_SUCCESS) {
-		d->engine.reset();
-		goto fail;
-	}
+	if (!event_source_init_engine(d)) goto fail;
 	d->source = source;
 	if (os_event_init(&d->event, OS_EVENT_TYPE_MANUAL) != 0) goto fail;
 	if (pthread_create(&d->thread, NULL, event_source_thread, d) != 0) goto fail;
 	d->initialized_thread = true;
 	d->global_events = false;
 	d->ui_event = nullptr;
-	g_audio_event_sources.push_back(d);
+	{
+		lock_guard<mutex> lock(g_audio_event_sources_lock);
+		g_audio_event_sources.push_back(d);
+	}
+	refresh_event_cache();
 	return d;
 	fail:
 		event_source_destroy(d);
@@ -124,36 +378,217 @@ bool init_audio(obs_data_t* settings) {
 	g_audio_event_source->global_events = true;
 	obs_source_inc_active(src);
 	obs_source_inc_showing(src);
+	remember_loaded_settings();
 	return true;
 }
 void shutdown_audio() {
 	// We only shut down our global source and trust that OBS did whatever was needed for any that were user created.
 	if (!g_audio_event_source) return;
+	set_direct_output(false);
 	obs_source_dec_showing(g_audio_event_source->source);
 	obs_source_dec_active(g_audio_event_source->source);
-	obs_source_remove(g_audio_event_source->source);
-	obs_source_release(g_audio_event_source->source);
-	g_audio_event_source = nullptr;
+	obs_source_t* source = g_audio_event_source->source;
+	g_audio_event_source = nullptr; // Destroying the source refreshes the event cache, which must not find it half destroyed.
+	obs_source_remove(source);
+	obs_source_release(source);
 }
-bool play(const string& earcon) {
-	bool success = false;
-	event_type* event = get_event_type(earcon);
+bool play(const event_type* event, uint64_t timestamp, const calldata_t* data, uint64_t* end_frame) {
+	if (end_frame) *end_frame = 0;
 	if (!event) return false;
+	bool success = false;
+	string rendered_template, rendered;
+	lock_guard<mutex> lock(g_audio_event_sources_lock);
 	for (event_source_data* src : g_audio_event_sources) {
-		if (!get_property_bool("sound", src->source) || event->get_muted(src->source)) continue;
-		string config_path = get_property_string("earcon_path");
-		if (config_path.empty()) {
-			char* tmp = obs_module_file("earcon");
-			if (!tmp) continue;
-			config_path = tmp;
-			bfree(tmp);
+		uint64_t* src_end_frame = src == g_audio_event_source? end_frame : nullptr; // Only the global source's clock is followed by the dispatch thread.
+		success = event_source_play_earcon(src, event->get_index(), timestamp, src_end_frame) || success;
+		success = event_source_play_tone(src, event->get_index(), timestamp, data, rendered_template, rendered, src_end_frame) || success;
+	}
+	return success;
+}
+bool play(string_view earcon) { return play(get_event_type(earcon)); }
+uint64_t get_mixer_frame() {
+	event_source_data* d = g_audio_event_source;
+	if (!d) return 0;
+	uint64_t frame, time;
+	uint32_t block;
+	event_source_read_clock(d, frame, time, block);
+	return time? frame + block : 0;
+}
+void wake_dispatch_at_frame(uint64_t frame) {
+	uint64_t due = g_dispatch_due_frame.load(memory_order_relaxed);
+	while ((!due || frame < due) && !g_dispatch_due_frame.compare_exchange_weak(due, frame, memory_order_relaxed));
+}
+void set_earcon_latency(int milliseconds) {
+	g_earcon_latency_ns = uint64_t(clamp(milliseconds, 0, 100)) * 1000000;
+}
+static void direct_output_callback(ma_device* device, void* output, const void* input, ma_uint32 frames) {
+	// This is the device's realtime thread, so it never waits on the mixer thread. The lock is only contended for the block where one hands over to the other, which plays as silence.
+	event_source_data* d = (event_source_data*)device->pUserData;
+	unique_lock<mutex> lock(d->render_lock, try_to_lock);
+	if (lock.owns_lock()) event_source_render_block(d, (float*)output, frames, os_gettime_ns());
+	else memset(output, 0, frames * 2 * sizeof(float));
+}
+static void stop_direct_output() {
+	// Call with g_direct_output_lock held. Uninitializing the device waits for its callback to return, after which the mixer thread takes over again from its next block.
+	if (g_direct_device) {
+		ma_device_uninit(&*g_direct_device);
+		g_direct_device.reset();
+	}
+	if (g_direct_context) {
+		ma_context_uninit(&*g_direct_context);
+		g_direct_context.reset();
+	}
+	if (g_direct_source) g_direct_source->direct.store(false, memory_order_release);
+	g_direct_source = nullptr;
+}
+bool set_direct_output(bool enabled, int period_ms, bool null_backend) {
+	lock_guard<mutex> lock(g_direct_output_lock);
+	event_source_data* d = enabled? g_audio_event_source : nullptr;
+	period_ms = clamp(period_ms, DIRECT_OUTPUT_MIN_PERIOD_MS, DIRECT_OUTPUT_MAX_PERIOD_MS);
+	if (d && d == g_direct_source && period_ms == g_direct_period_ms && null_backend == g_direct_null_backend) return true;
+	stop_direct_output();
+	if (!d) return !enabled;
+	ma_backend null_backends[] = {ma_backend_null};
+	g_direct_context = make_unique<ma_context>();
+	if (ma_context_init(null_backend? null_backends : nullptr, null_backend? 1 : 0, nullptr, &*g_direct_context) != MA_SUCCESS) {
+		g_direct_context.reset();
+		obs_log(LOG_WARNING, "no audio device for direct earcon output, earcons stay on OBS monitoring");
+		return false;
+	}
+	ma_device_config cfg = ma_device_config_init(ma_device_type_playback);
+	cfg.playback.format = ma_format_f32;
+	cfg.playback.channels = 2;
+	cfg.sampleRate = 48000; // The engine's own rate, the device converts if it has to.
+	cfg.periodSizeInMilliseconds = uint32_t(period_ms);
+	cfg.performanceProfile = ma_performance_profile_low_latency;
+	cfg.noPreSilencedOutputBuffer = MA_TRUE; // Every frame is written by the mixer.
+	cfg.dataCallback = direct_output_callback;
+	cfg.pUserData = d;
+	g_direct_device = make_unique<ma_device>();
+	if (ma_device_init(&*g_direct_context, &cfg, &*g_direct_device) != MA_SUCCESS) {
+		g_direct_device.reset();
+		stop_direct_output();
+		obs_log(LOG_WARNING, "could not open the playback device for direct earcon output, earcons stay on OBS monitoring");
+		return false;
+	}
+	g_direct_source = d;
+	g_direct_period_ms = period_ms;
+	g_direct_null_backend = null_backend;
+	d->direct.store(true, memory_order_release);
+	if (ma_device_start(&*g_direct_device) != MA_SUCCESS) {
+		stop_direct_output();
+		obs_log(LOG_WARNING, "could not start the playback device for direct earcon output, earcons stay on OBS monitoring");
+		return false;
+	}
+	return true;
+}
+bool should_stream_earcon(const string& path, uint64_t* frames) {
+	if (frames) *frames = 0;
+	error_code size_error, modified_error;
+	uintmax_t size = filesystem::file_size(path, size_error);
+	filesystem::file_time_type modified = filesystem::last_write_time(path, modified_error);
+	if (size_error || modified_error) return false;
+	{
+		lock_guard<mutex> lock(g_earcon_policy_lock);
+		auto it = g_earcon_policies.find(path);
+		if (it != g_earcon_policies.end() && it->second.size == size && it->second.modified == modified) {
+			if (frames) *frames = it->second.frames;
+			return it->second.stream;
 		}
-		for (const char** extension = g_audio_extensions; *extension; ++extension) {
-			filesystem::path path = filesystem::path(config_path) / string(earcon + *extension);
-			if (!filesystem::is_regular_file(path)) continue;
-			success = ma_engine_play_sound(&*src->engine, path.string().c_str(), nullptr) == MA_SUCCESS;
+	}
+	// Only files small enough to decode whole are opened, to see whether they would play for too long anyway, say a compressed countdown bed.
+	bool stream = size > EARCON_STREAM_BYTES;
+	ma_uint64 length = 0;
+	if (!stream) {
+		ma_decoder_config cfg = ma_decoder_config_init(ma_format_f32, 2, 48000);
+		ma_decoder decoder;
+		if (ma_decoder_init_file(path.c_str(), &cfg, &decoder) == MA_SUCCESS) {
+			if (ma_decoder_get_length_in_pcm_frames(&decoder, &length) != MA_SUCCESS) length = 0;
+			ma_decoder_uninit(&decoder);
 		}
+		stream = length > EARCON_STREAM_SECONDS * 48000;
 	}
-	return success;
+	if (stream) length = 0;
+	lock_guard<mutex> lock(g_earcon_policy_lock);
+	g_earcon_policies[path] = {modified, size, stream, length};
+	if (frames) *frames = length;
+	return stream;
+}
+void preload_earcons() {
+	// Decoded data registered with the shared resource manager is used by every later voice that loads the same file with MA_SOUND_FLAG_DECODE, in any event source.
+	event_source_data* d = g_audio_event_source;
+	if (!d || !d->engine) return;
+	vector<string> earcons;
+	{
+		lock_guard<mutex> lock(d->voice_lock);
+		for (const earcon_file& earcon : d->earcons) {
+			if (!earcon.path.empty() && !earcon.stream) earcons.push_back(earcon.path);
+		}
+	}
+	sort(earcons.begin(), earcons.end());
+	earcons.erase(unique(earcons.begin(), earcons.end()), earcons.end());
+	ma_resource_manager* resources = ma_engine_get_resource_manager(&*d->engine);
+	// Files from an earlier set that are no longer used are unregistered so that their decoded data is freed, those still used are kept rather than decoded again.
+	lock_guard<mutex> lock(g_preloaded_earcons_lock);
+	for (const string& path : g_preloaded_earcons) {
+		if (!binary_search(earcons.begin(), earcons.end(), path)) ma_resource_manager_unregister_file(resources, path.c_str());
+	}
+	for (const string& path : earcons) {
+		if (!binary_search(g_preloaded_earcons.begin(), g_preloaded_earcons.end(), path)) ma_resource_manager_register_file(resources, path.c_str(), MA_RESOURCE_MANAGER_DATA_SOURCE_FLAG_DECODE);
+	}
+	g_preloaded_earcons = std::move(earcons);
+}
+void refresh_event_cache() {
+	lock_guard<mutex> lock(g_audio_event_sources_lock);
+	for (event_source_data* src : g_audio_event_sources) event_source_refresh_earcons(src);
+	bool speech = get_property_bool("speech");
+	refresh_event_rules();
+	for (size_t i = 0; i < get_event_type_count(); i++) {
+		event_type* event = get_event_type(i);
+		bool active = speech && (!event->get_message().empty() || event_rules_speak(event->get_rules()));
+		for (size_t s = 0; s < g_audio_event_sources.size() && !active; s++) {
+			// A custom event type registered since this source was scanned has no entry yet.
+			const event_source_data* src = g_audio_event_sources[s];
+			active = i < src->earcons.size() && (!src->earcons[i].path.empty() || src->tone_specs[i].mode != TONE_OFF);
+		}
+		event->set_active(active);
+		event->set_low_priority(event->get_low_priority());
+	}
+	discard_prerendered_messages();
 }
 event_source_data* get_audio_event_source() { return g_audio_event_source; }
+bool render_offline(const vector<earcon_trigger>& script, uint64_t frames, vector<float>& out, const string& earcon_path) {
+	// The source is never registered in g_audio_event_sources, so play() and the rest of the plugin cannot see it.
+	event_source_data d{};
+	d.offline = true;
+	if (!event_source_init_engine(&d)) return false;
+	string config_path = earcon_path.empty()? get_default_earcon_path() : earcon_path;
+	vector<earcon_trigger> sorted = script;
+	stable_sort(sorted.begin(), sorted.end(), [](const earcon_trigger& a, const earcon_trigger& b) { return a.frame < b.frame; });
+	out.assign(frames * 2, 0.0f);
+	uint64_t cursor = 0;
+	auto next = sorted.begin();
+	while (cursor < frames) {
+		// Mixed in the same fixed blocks as event_source_thread, with triggers that fall inside a block started on their exact frame the same way live earcons are.
+		uint64_t block = min<uint64_t>(EVENT_SOURCE_BLOCK_FRAMES, frames - cursor);
+		for (; next != sorted.end() && next->frame < cursor + block; ++next) {
+			string path = filesystem::is_regular_file(next->earcon)? next->earcon : find_earcon(config_path, next->earcon);
+			if (!path.empty()) event_source_play_file(&d, path, next->volume, next->frame);
+		}
+		event_source_render(&d, &out[cursor * 2], block);
+		cursor += block;
+	}
+	event_source_uninit_engine(&d);
+	return true;
+}
+bool write_wav(const string& path, const vector<float>& samples) {
+	FILE* f = fopen(path.c_str(), "wb");
+	if (!f) return false;
+	uint32_t data_size = uint32_t(samples.size() * sizeof(float)), riff_size = 36 + data_size, fmt_size = 16, sample_rate = 48000, byte_rate = 48000 * 2 * sizeof(float);
+	uint16_t format = 3, channels = 2, block_align = 2 * sizeof(float), bits = 32; // WAVE_FORMAT_IEEE_FLOAT
+	bool success = fwrite("RIFF", 1, 4, f) == 4 && fwrite(&riff_size, 4, 1, f) && fwrite("WAVEfmt ", 1, 8, f) == 8 && fwrite(&fmt_size, 4, 1, f)
+		&& fwrite(&format, 2, 1, f) && fwrite(&channels, 2, 1, f) && fwrite(&sample_rate, 4, 1, f) && fwrite(&byte_rate, 4, 1, f) && fwrite(&block_align, 2, 1, f) && fwrite(&bits, 2, 1, f)
+		&& fwrite("data", 1, 4, f) == 4 && fwrite(&data_size, 4, 1, f) && fwrite(samples.data(), sizeof(float), samples.size(), f) == samples.size();
+	fclose(f);
+	return success;
+}
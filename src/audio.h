@@ -17,26 +17,85 @@
 */
 
 #pragma once
+#include <atomic>
 #include <miniaudio.h>
 #include <obs.h>
 #include <util/threading.h>
 #include <util/platform.h>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <string_view>
+#include <vector>
 #include "events.h"
+#include "tones.h"
 
+#define EVENT_SOURCE_MAX_VOICES 32 // Earcons that can sound at once per event source before the oldest is cut off.
+#define EVENT_SOURCE_BLOCK_FRAMES 480 // Frames mixed per block, 10 ms at 48 kHz.
+#define EARCON_STREAM_BYTES 1048576 // Earcon files larger than this are streamed rather than decoded whole.
+#define EARCON_STREAM_SECONDS 10 // As are files that play for longer than this.
+#define DIRECT_OUTPUT_MIN_PERIOD_MS 2 // Range of device periods set_direct_output() accepts.
+#define DIRECT_OUTPUT_MAX_PERIOD_MS 20
+
+struct event_voice {
+	ma_sound sound;
+	bool initialized;
+	uint64_t serial; // Order in which voices were started, used to pick which one to steal.
+};
+struct earcon_file {
+	std::string path; // Empty when there is none or it is muted.
+	bool stream; // Decoded a page at a time by the resource manager's job thread as it plays, see should_stream_earcon().
+	uint64_t frames; // Length at 48 kHz, 0 for streamed earcons.
+};
 // Defines custom data required for our event audio delivery and configuration source to function.
 struct event_source_data {
 	bool global_events;
 	bool initialized_thread;
+	bool offline; // Rendered on demand by render_offline instead of by a thread feeding OBS.
 	pthread_t thread;
 	os_event_t *event;
 	obs_source_t *source;
 	std::unique_ptr<ma_engine> engine;
+	std::mutex voice_lock;
+	std::unique_ptr<event_voice[]> voices;
+	uint64_t voice_serial;
+	// Frame and os_gettime_ns() time at which the mixer last started a block, published with a sequence lock so that earcons can be placed on the frame matching when their event arrived.
+	std::atomic<uint64_t> clock_sequence;
+	std::atomic<uint64_t> clock_frame;
+	std::atomic<uint64_t> clock_time;
+	std::atomic<uint32_t> clock_block; // Frames in that block, which is smaller than EVENT_SOURCE_BLOCK_FRAMES while a direct output device drives the mixer.
+	std::mutex render_lock; // Serializes the mixer thread and a direct output device while one hands over to the other. The device only ever tries it.
+	std::atomic<bool> direct; // Rendered by a direct output device rather than the mixer thread, see set_direct_output().
+	std::atomic<uint64_t> late_voices; // Earcons whose event arrived too late for the latency target, started at the next block instead.
+	std::vector<earcon_file> earcons; // Resolved earcon file per event index. Guarded by voice_lock.
+	std::vector<tone_spec> tone_specs; // Parsed value tone per event index, also guarded by voice_lock, which makes whoever holds it the tone bank's one producer.
+	tone_bank tones;
 	event_type* ui_event; // Keeps track of the event settings are being changed for.
+	std::string cached_settings; // The settings refresh_event_cache last saw, so that dialog only changes don't rescan earcons.
+	std::string applied_settings; // The global settings event_source_update last applied, see describe_applied_settings().
+};
+// One scripted earcon for render_offline.
+struct earcon_trigger {
+	uint64_t frame; // Offset from the start of the render at which the earcon begins.
+	std::string earcon; // Either an event ID looked up the same way play() does, or a path to a sound file.
+	float volume = 1.0f;
 };
 
 bool init_audio(obs_data_t* settings = nullptr);
 void shutdown_audio();
-bool play(const std::string& earcon);
+// timestamp is the os_gettime_ns() time the event arrived, the earcon starts exactly the earcon latency after it when the mixer can still manage that. 0 starts it at the next block. data is the event's calldata, which value tones are rendered from. end_frame receives the global source frame at which what it played finishes, or 0 if it played nothing whose length is known.
+bool play(const event_type* event, uint64_t timestamp = 0, const calldata_t* data = nullptr, uint64_t* end_frame = nullptr);
+bool play(std::string_view earcon);
+uint64_t get_mixer_frame(); // The global source frame just past the block being mixed, 0 if its mixer isn't running.
+void wake_dispatch_at_frame(uint64_t frame); // Has the global source's mixer call wake_dispatch() once it mixes the block containing frame. Only the earliest pending frame is kept.
+void set_earcon_latency(int milliseconds); // 0 starts every earcon at the next block.
+// Plays the global source's earcons and tones straight to the default playback device with the given period, instead of through OBS's mix and monitoring buffers. Sources added to scenes keep going through OBS, so cues meant to be recorded still are. Returns false and leaves the global source on OBS monitoring if no device could be opened. null_backend uses miniaudio's null device, which keeps time without making a sound, for testing.
+bool set_direct_output(bool enabled, int period_ms = 5, bool null_backend = false);
+void preload_earcons(); // Decodes the global source's earcons ahead of time so that the first time each plays it doesn't wait on the disk. Streamed earcons are left alone, and those preloaded by an earlier call but no longer used are released.
+// Long earcons such as loops or countdown beds are streamed so that memory use doesn't grow with them, everything else is decoded once and shared by every event source. The answer is cached per file until it changes on disk, along with the length of those that are not streamed, which frames receives.
+bool should_stream_earcon(const std::string& path, uint64_t* frames = nullptr);
+void refresh_event_cache(); // Rescans earcon files for every event source and recomputes which events have anything to announce, call whenever settings change.
 event_source_data* get_audio_event_source();
+// Renders a script of earcons through the same mixing code event sources use, without OBS or a real clock, into interleaved 48 kHz stereo float samples. If earcon_path is empty the default earcon directory is used.
+bool render_offline(const std::vector<earcon_trigger>& script, uint64_t frames, std::vector<float>& out, const std::string& earcon_path = "");
+bool write_wav(const std::string& path, const std::vector<float>& samples); // 32 bit float 48 kHz stereo.
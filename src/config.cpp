@@ -16,22 +16,71 @@
  with this program. If not, see <https://www.gnu.org/licenses/>
 */
 
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <mutex>
 #include <string>
 #include <vector>
 #include <obs.h>
 #include <obs.hpp>
+#include <obs-accessibility.h>
 #include <obs-module.h>
 #include <obs-properties.h>
+#include <util/platform.h>
+#include <util/threading.h>
+#include <fmt/format.h>
 #include "audio.h" // Config and audio are somewhat linked because OBS makes it convenient for us to not only save config data in sources but to also generate a properties dialog for them.
 #include "config.h"
 #include "events.h"
-#include "interface.h"
+#include "levels.h"
+#include "logs.h"
+#include "monitor.h"
 #include "speech.h"
+#include "stream.h"
+#include "text.h"
+#include "video.h"
 
 using namespace std;
+using namespace fmt;
 
 OBSDataAutoRelease get_event_config(const string& event_id, obs_source_t* source = nullptr, bool create = false);
 
+// The events combo is translated once per locale and reused every time a dialog opens or is searched. Only touched from the UI thread.
+struct event_list_entry {
+	string id;
+	string description;
+	string search_text; // Lowercase description and id.
+};
+vector<event_list_entry> g_event_list;
+string g_event_list_locale;
+string lowercase(string text) {
+	for (char& c : text) c = tolower((unsigned char)c);
+	return text;
+}
+const vector<event_list_entry>& get_event_list() {
+	const char* locale = obs_get_locale();
+	if (!locale) locale = "";
+	if (g_event_list.size() == get_event_type_count() && g_event_list_locale == locale) return g_event_list;
+	g_event_list.clear();
+	g_event_list.reserve(get_event_type_count());
+	for (size_t i = 0; i < get_event_type_count(); i++) {
+		event_type* event = get_event_type(i);
+		string description = event->describe();
+		g_event_list.push_back({event->get_id(), description, lowercase(description + " " + event->get_id())});
+	}
+	sort(g_event_list.begin(), g_event_list.end(), [](const event_list_entry& a, const event_list_entry& b) { return a.description < b.description; });
+	g_event_list_locale = locale;
+	return g_event_list;
+}
+void fill_event_list(obs_property_t* list, const char* search) {
+	obs_property_list_clear(list);
+	string needle = lowercase(search? search : "");
+	for (const event_list_entry& e : get_event_list()) {
+		if (needle.empty() || e.search_text.find(needle) != string::npos) obs_property_list_add_string(list, e.description.c_str(), e.id.c_str());
+	}
+}
+
 // Configuration properties. We might be stretching the intent for the obs_properties API juuust a bit, but the idea is to use the properties API to construct a settings dialog for the entire plugin while also allowing users to change fewer settings if they manually create an audio events source.
 bool on_event_edit(obs_properties_t* settings, obs_property_t* property, void* data) {
 	event_source_data* src = (event_source_data*)obs_properties_get_param(settings);
@@ -43,11 +92,20 @@ bool on_event_edit(obs_properties_t* settings, obs_property_t* property, void* d
 	obs_property_t* event_edit_group = obs_properties_get(settings, "event_edit");
 	obs_property_set_description(event_edit_group, event->get_name().c_str());
 	obs_property_set_visible(event_edit_group, true);
+	// The edit fields are dialog state only, so they are written straight into the settings the dialog displays instead of going through obs_source_update.
 	OBSDataAutoRelease change = obs_source_get_settings(src->source);
 	obs_data_set_string(change, "event_id", event_id.c_str());
 	obs_data_set_bool(change, "event_muted", event->get_muted(src->source));
+	obs_data_set_string(change, "event_tone", event->get_tone(src->source).c_str());
+	obs_data_set_bool(change, "event_low_priority", event->get_low_priority());
+	obs_data_set_string(change, "event_timing", get_event_string(event_id, "timing", "together").c_str());
 	obs_data_set_string(change, "event_message", event->get_message(src->source).c_str());
-	obs_source_update(src->source, change);
+	if (src->global_events) {
+		OBSDataAutoRelease event_config = get_event_config(event_id);
+		OBSDataArrayAutoRelease rules = event_config? obs_data_get_array(event_config, "rules") : nullptr;
+		if (!rules) rules = obs_data_array_create();
+		obs_data_set_array(change, "event_rules", rules);
+	}
 	return true;
 }
 bool on_event_edit_message_default(obs_properties_t* settings, obs_property_t* property, void* data) {
@@ -56,7 +114,6 @@ bool on_event_edit_message_default(obs_properties_t* settings, obs_property_t* p
 	string msg = src->ui_event->get_default_message();
 	OBSDataAutoRelease change = obs_source_get_settings(src->source);
 	obs_data_set_string(change, "event_message", msg.c_str());
-	obs_source_update(src->source, change);
 	return true;
 }
 bool on_event_edit_save(obs_properties_t* settings, obs_property_t* property, void* data) {
@@ -65,7 +122,16 @@ bool on_event_edit_save(obs_properties_t* settings, obs_property_t* property, vo
 	OBSDataAutoRelease src_settings = obs_source_get_settings(src->source);
 	OBSDataAutoRelease event = get_event_config(src->ui_event->get_id(), src->source, true);
 	obs_data_set_bool(event, "muted", obs_data_get_bool(src_settings, "event_muted"));
+	obs_data_set_string(event, "tone", obs_data_get_string(src_settings, "event_tone"));
+	if (src->global_events) obs_data_set_bool(event, "low_priority", obs_data_get_bool(src_settings, "event_low_priority"));
+	if (src->global_events) obs_data_set_string(event, "timing", obs_data_get_string(src_settings, "event_timing"));
 	obs_data_set_string(event, "message", obs_data_get_string(src_settings, "event_message"));
+	if (src->global_events) {
+		OBSDataArrayAutoRelease rules = obs_data_get_array(src_settings, "event_rules");
+		obs_data_set_array(event, "rules", rules);
+	}
+	refresh_event_cache();
+	mark_config_dirty();
 	obs_property_set_visible(obs_properties_get(settings, "event_edit"), false);
 	obs_property_set_visible(obs_properties_get(settings, "event_edit_btn"), true);
 	src->ui_event = nullptr;
@@ -83,14 +149,87 @@ void event_source_defaults(obs_data_t* settings) {
 	obs_data_set_default_bool(settings, "speech_interrupt", "false");
 	obs_data_set_default_bool(settings, "sound", true);
 	obs_data_set_default_string(settings, "earcon_path", "");
+	obs_data_set_default_string(settings, "speech_backend", "");
+	obs_data_set_default_bool(settings, "shed_load", true);
+	obs_data_set_default_int(settings, "shed_cpu", 90);
+	obs_data_set_default_int(settings, "level_silence_db", -60);
+	obs_data_set_default_int(settings, "level_silence_seconds", 10);
+	obs_data_set_default_bool(settings, "video_monitor", false);
+	obs_data_set_default_bool(settings, "event_stream", false);
+	obs_data_set_default_int(settings, "earcon_latency_ms", 20);
+	obs_data_set_default_bool(settings, "direct_output", false);
+	obs_data_set_default_int(settings, "direct_output_period_ms", 5);
+}
+static vector<string> get_string_list(obs_data_t* settings, const char* key) {
+	// Editable lists store each entry as an object whose value key holds the text.
+	vector<string> out;
+	OBSDataArrayAutoRelease list = obs_data_get_array(settings, key);
+	for (size_t i = 0; list && i < obs_data_array_count(list); i++) {
+		OBSDataAutoRelease item = obs_data_array_item(list, i);
+		const char* value = obs_data_get_string(item, "value");
+		if (value && *value) out.push_back(value);
+	}
+	return out;
+}
+bool on_event_search(obs_properties_t* props, obs_property_t* property, obs_data_t* settings) {
+	fill_event_list(obs_properties_get(props, "event_list"), obs_data_get_string(settings, "event_search"));
+	return true;
+}
+const char* g_applied_bool_settings[] = {"speech", "speech_interrupt", "sound", "shed_load", "video_monitor", "event_stream", "direct_output", nullptr};
+const char* g_applied_int_settings[] = {"shed_cpu", "level_silence_db", "level_silence_seconds", "earcon_latency_ms", "direct_output_period_ms", nullptr};
+const char* g_applied_string_settings[] = {"speech_backend", "earcon_path", nullptr};
+const char* g_applied_list_settings[] = {"level_sources", "log_patterns", nullptr};
+static string describe_applied_settings(obs_data_t* settings) {
+	// Every setting of the global source that outlives the dialog, so that keystrokes in dialog only fields such as the event search neither reapply them nor mark the config dirty.
+	string out;
+	for (const char** key = g_applied_bool_settings; *key; ++key) out += obs_data_get_bool(settings, *key)? '1' : '0';
+	for (const char** key = g_applied_int_settings; *key; ++key) out += to_string(obs_data_get_int(settings, *key)) + '\n';
+	for (const char** key = g_applied_string_settings; *key; ++key) out += string(obs_data_get_string(settings, *key)) + '\n';
+	for (const char** key = g_applied_list_settings; *key; ++key) {
+		for (const string& entry : get_string_list(settings, *key)) out += entry + '\t';
+		out += '\n';
+	}
+	return out;
+}
+static string describe_cached_settings(obs_data_t* settings) {
+	return string(obs_data_get_bool(settings, "sound")? "1" : "0") + (obs_data_get_bool(settings, "speech")? "1" : "0") + obs_data_get_string(settings, "earcon_path");
 }
 void event_source_update(void* data, obs_data_t* settings) {
+	// Sound, speech and earcon path all decide which events are worth dispatching, anything else changed here is dialog state.
+	event_source_data* d = (event_source_data*)data;
+	string applied_settings = d && d->global_events? describe_applied_settings(settings) : "";
+	if (d && d->global_events && d->applied_settings != applied_settings) {
+		d->applied_settings = applied_settings;
+		set_speech_backend(obs_data_get_string(settings, "speech_backend"));
+		set_load_shedding(obs_data_get_bool(settings, "shed_load"), obs_data_get_int(settings, "shed_cpu"));
+		set_level_sources(get_string_list(settings, "level_sources"));
+		set_level_silence(obs_data_get_int(settings, "level_silence_db"), obs_data_get_int(settings, "level_silence_seconds"));
+		set_log_patterns(get_string_list(settings, "log_patterns"));
+		set_video_monitor(obs_data_get_bool(settings, "video_monitor"));
+		set_event_stream(obs_data_get_bool(settings, "event_stream"));
+		set_earcon_latency(obs_data_get_int(settings, "earcon_latency_ms"));
+		set_direct_output(obs_data_get_bool(settings, "direct_output"), obs_data_get_int(settings, "direct_output_period_ms"));
+		mark_config_dirty();
+	}
+	string cached_settings = describe_cached_settings(settings);
+	if (d && d->cached_settings == cached_settings) return;
+	if (d) d->cached_settings = cached_settings;
+	refresh_event_cache();
+	if (d && d->global_events) preload_earcons(); // The startup thread preloads what was loaded in the first place.
 }
+thread_local bool g_config_snapshot = false; // Set while serialize_config() runs obs_save_source.
 void event_source_save(void* data, obs_data_t* settings) {
 	// Remove any temporary variables only used for the UI.
+	if (g_config_snapshot) return; // These are the live settings an open dialog may still be using, serialize_config() strips a copy instead.
 	obs_data_erase(settings, "event_list");
+	obs_data_erase(settings, "event_search");
+	obs_data_erase(settings, "speech_backend_stats");
 	obs_data_erase(settings, "event_muted");
+	obs_data_erase(settings, "event_tone");
+	obs_data_erase(settings, "event_low_priority");
+	obs_data_erase(settings, "event_timing");
 	obs_data_erase(settings, "event_message");
+	obs_data_erase(settings, "event_rules");
 	obs_data_erase(settings, "event_edit");
 	obs_data_erase(settings, "event_id");
 }
@@ -101,21 +240,55 @@ obs_properties_t* event_source_getprops(void* data) {
 	if (d->global_events) {
 		obs_properties_add_bool(props, "speech", obs_module_text("props.speech"));
 		obs_properties_add_bool(props, "speech_interrupt", obs_module_text("props.speech_interrupt"));
+		// Backends and their measured latency, as of the moment the dialog was opened.
+		obs_property_t* backend_list = obs_properties_add_list(props, "speech_backend", obs_module_text("props.speech_backend"), OBS_COMBO_TYPE_LIST, OBS_COMBO_FORMAT_STRING);
+		obs_property_list_add_string(backend_list, obs_module_text("props.speech_backend.auto"), "");
+		obs_property_list_add_string(backend_list, obs_module_text("props.speech_backend.fastest"), SPEECH_FASTEST_CHOICE);
+		string stats_text;
+		for (const speech_backend_stats& b : get_speech_backend_stats()) {
+			obs_property_list_add_string(backend_list, b.name.c_str(), b.name.c_str());
+			if (!stats_text.empty()) stats_text += "\n";
+			stats_text += format(runtime(_t(b.selected? "props.speech_backend.stats_selected" : "props.speech_backend.stats")), b.name, b.init_ms, b.average_ms, b.calls, b.failures);
+		}
+		obs_properties_add_text(props, "speech_backend_stats", obs_module_text("props.speech_backend.stats_label"), OBS_TEXT_INFO);
+		OBSDataAutoRelease settings = obs_source_get_settings(d->source);
+		obs_data_set_string(settings, "speech_backend_stats", stats_text.c_str());
+		obs_properties_add_bool(props, "shed_load", obs_module_text("props.shed_load"));
+		obs_properties_add_int_slider(props, "shed_cpu", obs_module_text("props.shed_cpu"), 50, 100, 1);
+		obs_properties_add_editable_list(props, "level_sources", obs_module_text("props.level_sources"), OBS_EDITABLE_LIST_TYPE_STRINGS, nullptr, nullptr);
+		obs_properties_add_int_slider(props, "level_silence_db", obs_module_text("props.level_silence_db"), -90, -20, 1);
+		obs_properties_add_int(props, "level_silence_seconds", obs_module_text("props.level_silence_seconds"), 2, 300, 1);
+		obs_properties_add_bool(props, "video_monitor", obs_module_text("props.video_monitor"));
+		obs_properties_add_editable_list(props, "log_patterns", obs_module_text("props.log_patterns"), OBS_EDITABLE_LIST_TYPE_STRINGS, nullptr, nullptr);
+#ifndef _WIN32
+		obs_properties_add_bool(props, "event_stream", obs_module_text("props.event_stream")); // Unix sockets only, see stream.cpp.
+#endif
+		obs_properties_add_int(props, "earcon_latency_ms", obs_module_text("props.earcon_latency_ms"), 0, 100, 1);
+		obs_properties_add_bool(props, "direct_output", obs_module_text("props.direct_output"));
+		obs_properties_add_int(props, "direct_output_period_ms", obs_module_text("props.direct_output_period_ms"), DIRECT_OUTPUT_MIN_PERIOD_MS, DIRECT_OUTPUT_MAX_PERIOD_MS, 1);
 	}
 	obs_properties_add_bool(props, "sound", obs_module_text("props.sound"));
 	obs_properties_add_path(props, "earcon_path", obs_module_text("props.earcon_path"), OBS_PATH_DIRECTORY, "", "");
+	obs_property_t* event_search = obs_properties_add_text(props, "event_search", obs_module_text("props.events.search"), OBS_TEXT_DEFAULT);
+	obs_property_set_modified_callback(event_search, on_event_search);
 	obs_property_t* event_list = obs_properties_add_list(props, "event_list", obs_module_text("props.events"), OBS_COMBO_TYPE_LIST, OBS_COMBO_FORMAT_STRING);
-	vector<string> events;
-	get_event_types(events);
-	for (auto i : events) obs_property_list_add_string(event_list, get_event_type(i)->describe().c_str(), i.c_str());
+	OBSDataAutoRelease source_settings = obs_source_get_settings(d->source);
+	fill_event_list(event_list, obs_data_get_string(source_settings, "event_search"));
 	obs_properties_add_button(props, "event_edit_btn", obs_module_text("props.event.edit"), on_event_edit);
 	obs_properties_t* event_edit = obs_properties_create();
 	obs_property_t* event_edit_group = obs_properties_add_group(props, "event_edit", "", OBS_GROUP_NORMAL, event_edit);
 	obs_properties_add_text(event_edit, "event_id", obs_module_text("props.event.id"), OBS_TEXT_INFO);
 	obs_properties_add_bool(event_edit, "event_muted", obs_module_text("props.event.mute"));
+	obs_properties_add_text(event_edit, "event_tone", obs_module_text("props.event.tone"), OBS_TEXT_DEFAULT);
 	if (d->global_events) {
+		obs_properties_add_bool(event_edit, "event_low_priority", obs_module_text("props.event.low_priority"));
+		obs_property_t* timing_list = obs_properties_add_list(event_edit, "event_timing", obs_module_text("props.event.timing"), OBS_COMBO_TYPE_LIST, OBS_COMBO_FORMAT_STRING);
+		obs_property_list_add_string(timing_list, obs_module_text("props.event.timing.together"), "together");
+		obs_property_list_add_string(timing_list, obs_module_text("props.event.timing.after_earcon"), "after_earcon");
+		obs_property_list_add_string(timing_list, obs_module_text("props.event.timing.earcon_when_busy"), "earcon_when_busy");
 		obs_properties_add_text(event_edit, "event_message", obs_module_text("props.event.message"), OBS_TEXT_DEFAULT);
 		obs_properties_add_button(event_edit, "event_edit_message_default", obs_module_text("props.event.message_default"), on_event_edit_message_default);
+		obs_properties_add_editable_list(event_edit, "event_rules", obs_module_text("props.event.rules"), OBS_EDITABLE_LIST_TYPE_STRINGS, nullptr, nullptr);
 	}
 	obs_properties_add_button(event_edit, "event_edit_save", obs_module_text("props.event.save"), on_event_edit_save);
 	obs_properties_add_button(event_edit, "event_edit_cancel", obs_module_text("props.event.cancel"), on_event_edit_cancel);
@@ -149,19 +322,28 @@ OBSDataAutoRelease get_hotkeys_config() {
 	}
 	return hotkeys;
 }
-bool get_property_bool(const string& key, obs_source_t* source) {
+bool get_property_bool(const char* key, obs_source_t* source) {
+	OBSDataAutoRelease settings = get_properties(source);
+	return settings? obs_data_get_bool(settings, key) : false;
+}
+long long get_property_int(const char* key, obs_source_t* source) {
 	OBSDataAutoRelease settings = get_properties(source);
-	return settings? obs_data_get_bool(settings, key.c_str()) : false;
+	return settings? obs_data_get_int(settings, key) : 0;
 }
-string get_property_string(const string& key, obs_source_t* source) {
+vector<string> get_property_strings(const char* key, obs_source_t* source) {
 	OBSDataAutoRelease settings = get_properties(source);
-	const char* str = settings? obs_data_get_string(settings, key.c_str()) : nullptr;
+	return settings? get_string_list(settings, key) : vector<string>();
+}
+string get_property_string(const char* key, obs_source_t* source) {
+	OBSDataAutoRelease settings = get_properties(source);
+	const char* str = settings? obs_data_get_string(settings, key) : nullptr;
 	return str? str : "";
 }
 OBSDataAutoRelease get_event_config(const string& event_id, obs_source_t* source, bool create) {
 	OBSDataAutoRelease settings = get_config(source);
 	if (!settings) return nullptr;
 	OBSDataAutoRelease events = obs_data_get_obj(settings, "events");
+	if (!events && !create) return nullptr;
 	if (!events) {
 		events = obs_data_create();
 		obs_data_set_obj(settings, "events", events);
@@ -173,35 +355,109 @@ OBSDataAutoRelease get_event_config(const string& event_id, obs_source_t* source
 	}
 	return event;
 }
-bool get_event_bool(const string& event_id, const string& key, bool default_value, obs_source_t* source) {
-	OBSDataAutoRelease event = get_event_config(event_id);
-	return event? obs_data_get_bool(event, key.c_str()) : default_value;
+bool get_event_bool(const string& event_id, const char* key, bool default_value, obs_source_t* source) {
+	OBSDataAutoRelease event = get_event_config(event_id, source);
+	return event && obs_data_has_user_value(event, key)? obs_data_get_bool(event, key) : default_value;
 }
-string get_event_string(const string& event_id, const string& key, const string& default_value, obs_source_t* source) {
-	OBSDataAutoRelease event = get_event_config(event_id);
-	const char* str = event? obs_data_get_string(event, key.c_str()) : nullptr;
+string get_event_string(const string& event_id, const char* key, const string& default_value, obs_source_t* source) {
+	OBSDataAutoRelease event = get_event_config(event_id, source);
+	const char* str = event && obs_data_has_user_value(event, key)? obs_data_get_string(event, key) : nullptr;
 	return str? str : default_value;
 }
-bool save_config() {
-	event_source_data* src = get_audio_event_source();
-	if (!src) return false;
+vector<string> get_event_strings(const string& event_id, const char* key, obs_source_t* source) {
+	OBSDataAutoRelease event = get_event_config(event_id, source);
+	return event? get_string_list(event, key) : vector<string>();
+}
+// Background config writer. A change is serialized on the thread that made it, then written once no further change has arrived for CONFIG_AUTOSAVE_DELAY_MS, so that a crash loses at most the last couple of seconds of edits.
+mutex g_autosave_lock;
+string g_autosave_pending; // Compact JSON waiting to be written, empty when there is nothing to save.
+string g_autosave_written; // Last JSON written, only touched by whichever thread is writing.
+atomic<bool> g_autosave_running = false;
+os_event_t* g_autosave_wake = nullptr;
+pthread_t g_autosave_thread;
+string serialize_config(obs_source_t* source) {
+	// Everything obs_save_source writes, volume, mixers and filters included, with dialog state stripped from a copy of the settings rather than from the live ones.
+	g_config_snapshot = true;
+	OBSDataAutoRelease data = obs_save_source(source);
+	g_config_snapshot = false;
+	if (!data) return "";
+	OBSDataAutoRelease current_settings = obs_data_get_obj(data, "settings");
+	OBSDataAutoRelease settings = obs_data_create();
+	obs_data_apply(settings, current_settings);
+	event_source_save(nullptr, settings);
+	obs_data_set_obj(data, "settings", settings);
+	const char* json = obs_data_get_json(data);
+	return json? json : "";
+}
+bool write_config(const string& json) {
+	if (json == g_autosave_written) return true;
 	char* config_dir = obs_module_config_path(nullptr);
 	if (!config_dir) return false;
 	os_mkdirs(config_dir);
 	bfree(config_dir);
 	char* file = obs_module_config_path("accessibility.json");
 	if (!file) return false;
-	obs_data_t* settings = obs_save_source(src->source);
-	if (!settings) {
-		bfree(file);
-		return false;
-	}
-	bool success =obs_data_save_json_pretty_safe(settings, file, ".tmp", ".bak");
+	bool success = os_quick_write_utf8_file_safe(file, json.c_str(), json.size(), false, ".tmp", ".bak");
 	bfree(file);
-	obs_data_release(settings);
+	if (success) g_autosave_written = json;
 	return success;
 }
+void remember_loaded_settings() {
+	// OBS doesn't call update when the global source is loaded, the startup thread applies what was loaded instead. Recording it here means the first change made afterwards is seen as one.
+	event_source_data* d = get_audio_event_source();
+	if (!d) return;
+	OBSDataAutoRelease settings = obs_source_get_settings(d->source);
+	d->applied_settings = describe_applied_settings(settings);
+	d->cached_settings = describe_cached_settings(settings);
+	g_autosave_written = serialize_config(d->source); // What was loaded needs no writing back, so an exit without changes leaves the file alone.
+}
+bool take_pending_config(string& json) {
+	lock_guard<mutex> lock(g_autosave_lock);
+	json.swap(g_autosave_pending);
+	g_autosave_pending.clear();
+	return !json.empty();
+}
+void* autosave_thread(void* arg) {
+	os_set_thread_name("accessibility: autosave");
+	while (os_event_wait(g_autosave_wake) == 0 && g_autosave_running) {
+		// Every change that arrives during the quiet period starts it over.
+		while (g_autosave_running && os_event_timedwait(g_autosave_wake, CONFIG_AUTOSAVE_DELAY_MS) == 0);
+		if (!g_autosave_running) break;
+		string json;
+		if (take_pending_config(json) && !write_config(json)) obs_log(LOG_WARNING, "failed to save accessibility config");
+	}
+	return nullptr;
+}
+void mark_config_dirty() {
+	event_source_data* src = get_audio_event_source();
+	if (!src) return;
+	string json = serialize_config(src->source);
+	{
+		lock_guard<mutex> lock(g_autosave_lock);
+		g_autosave_pending = move(json);
+	}
+	if (g_autosave_running) os_event_signal(g_autosave_wake);
+}
+bool save_config() {
+	// Autosaves only follow changes the plugin knows about, so exit serializes the whole source once more, catching anything changed elsewhere such as its monitoring type.
+	if (g_autosave_running.exchange(false)) {
+		os_event_signal(g_autosave_wake);
+		pthread_join(g_autosave_thread, nullptr);
+	}
+	string json;
+	take_pending_config(json); // Superseded by the full save below whenever the global source still exists.
+	event_source_data* src = get_audio_event_source();
+	if (src) json = serialize_config(src->source);
+	return json.empty() || write_config(json); // Nothing is written if it matches what is already on disk.
+}
 obs_data_t* load_config() {
+	if (!g_autosave_running) {
+		if (!g_autosave_wake && os_event_init(&g_autosave_wake, OS_EVENT_TYPE_AUTO) != 0) obs_log(LOG_WARNING, "accessibility config will only be saved on exit");
+		else {
+			g_autosave_running = true;
+			if (pthread_create(&g_autosave_thread, nullptr, autosave_thread, nullptr) != 0) g_autosave_running = false;
+		}
+	}
 	char* file = obs_module_config_path("accessibility.json");
 	if (!file) return nullptr;
 	obs_data_t* settings = obs_data_create_from_json_file_safe(file, ".bak");
@@ -17,10 +17,14 @@
 */
 
 #pragma once
+#include <string>
+#include <vector>
 #include <obs-data.h>
 #include <obs-properties.h>
 #include <obs.hpp>
 
+#define CONFIG_AUTOSAVE_DELAY_MS 2000 // Quiet period after the last settings change before the config is written.
+
 // Functions defined by our event source to make properties work, set up in audio.cpp.
 void event_source_save(void* data, obs_data_t* settings);
 void event_source_update(void* data, obs_data_t* settings);
@@ -29,9 +33,14 @@ obs_properties_t* event_source_getprops(void* data);
 
 OBSDataAutoRelease get_config(obs_source_t* source = nullptr);
 OBSDataAutoRelease get_hotkeys_config();
-bool get_property_bool(const std::string& key, obs_source_t* source = nullptr);
-std::string get_property_string(const std::string& key, obs_source_t* source = nullptr);
-bool get_event_bool(const std::string& event_id, const std::string& key, bool default_value = false, obs_source_t* source = nullptr);
-std::string get_event_string(const std::string& event_id, const std::string& key, const std::string& default_value = "", obs_source_t* source = nullptr);
-bool save_config(); // Call once when app begins to exit, before shutdown_audio().
-obs_data_t* load_config(); // Call once on module load and pass return value to init_audio().
+bool get_property_bool(const char* key, obs_source_t* source = nullptr);
+std::string get_property_string(const char* key, obs_source_t* source = nullptr);
+long long get_property_int(const char* key, obs_source_t* source = nullptr);
+std::vector<std::string> get_property_strings(const char* key, obs_source_t* source = nullptr); // Entries of an editable list.
+bool get_event_bool(const std::string& event_id, const char* key, bool default_value = false, obs_source_t* source = nullptr);
+std::string get_event_string(const std::string& event_id, const char* key, const std::string& default_value = "", obs_source_t* source = nullptr);
+std::vector<std::string> get_event_strings(const std::string& event_id, const char* key, obs_source_t* source = nullptr); // Entries of an editable list.
+void remember_loaded_settings(); // Called by init_audio() once the global source exists, so that later updates can tell what changed.
+void mark_config_dirty(); // Call after changing the global source's settings, they are saved in the background once changes stop arriving.
+bool save_config(); // Call once when app begins to exit, before shutdown_audio(). Stops the background writer and saves the whole global source if it changed.
+obs_data_t* load_config(); // Call once on module load and pass return value to init_audio(). Also starts the background writer.
@@ -0,0 +1,170 @@
+/*
+ OBS Accessibility
+ Copyright (C) 2025 Sam Tupy Productions <webmaster@samtupy.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along
+ with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <obs.h>
+#include <util/platform.h>
+#include <util/threading.h>
+#include "audio.h"
+#include "dispatch.h"
+#include "rules.h"
+
+using namespace std;
+
+// A bounded multi producer, single consumer ring of preallocated jobs. Each slot's sequence number says whether it is free for the producer that claims that position or ready for the consumer, so neither side needs a lock.
+struct dispatch_job {
+	atomic<size_t> sequence;
+	event_type* event;
+	uint64_t timestamp; // os_gettime_ns() when the event was received.
+	bool prerendered;
+	bool earcon_only; // Plays the earcon and tone, without speaking or publishing anything.
+	const event_rule* rule; // The event's rule that matched, programs outlive the dispatch thread.
+	bool has_data;
+	calldata_t data; // Points into stack.
+	obs_source_t* refs[2]; // Strong references taken on the source and filter parameters for as long as the job is queued.
+	uint8_t stack[DISPATCH_CALLDATA_SIZE];
+};
+const char* g_dispatch_ref_params[2] = {"source", "filter"};
+const char* g_dispatch_identity_params[2][3] = {{"source.name", "source.uuid", "source.typeid"}, {"filter.name", "filter.uuid", "filter.typeid"}};
+unique_ptr<dispatch_job[]> g_dispatch_jobs;
+atomic<size_t> g_dispatch_enqueue_pos = 0;
+size_t g_dispatch_dequeue_pos = 0;
+atomic<uint64_t> g_dispatch_dispatched = 0, g_dispatch_dropped = 0, g_dispatch_filtered = 0, g_dispatch_finished = 0;
+atomic<bool> g_dispatch_running = false;
+os_event_t* g_dispatch_wake = nullptr;
+pthread_t g_dispatch_thread;
+
+static void copy_calldata(dispatch_job* job, const calldata_t* data) {
+	job->has_data = data != nullptr;
+	if (!data) return;
+	if (data->stack && data->size <= DISPATCH_CALLDATA_SIZE) {
+		memcpy(job->stack, data->stack, data->size);
+		job->data.stack = job->stack;
+		job->data.size = data->size;
+		job->data.capacity = DISPATCH_CALLDATA_SIZE;
+		job->data.fixed = true;
+	} else {
+		calldata_init_fixed(&job->data, job->stack, DISPATCH_CALLDATA_SIZE);
+		for (const char* param : g_dispatch_ref_params) {
+			void* ptr = nullptr;
+			if (calldata_get_ptr(data, param, &ptr)) calldata_set_ptr(&job->data, param, ptr);
+		}
+	}
+	for (int i = 0; i < 2; i++) {
+		// A source that can no longer be referenced is being destroyed, as with every source_destroy signal. It is hidden from the dispatch thread rather than left to dangle, but its identity is copied while it is still valid so that {source.name} and friends still render.
+		void* ptr = nullptr;
+		if (!calldata_get_ptr(&job->data, g_dispatch_ref_params[i], &ptr) || !ptr) continue;
+		job->refs[i] = obs_source_get_ref((obs_source_t*)ptr);
+		if (job->refs[i]) continue;
+		obs_source_t* source = (obs_source_t*)ptr;
+		calldata_set_ptr(&job->data, g_dispatch_ref_params[i], nullptr);
+		calldata_set_string(&job->data, g_dispatch_identity_params[i][0], obs_source_get_name(source));
+		calldata_set_string(&job->data, g_dispatch_identity_params[i][1], obs_source_get_uuid(source));
+		calldata_set_string(&job->data, g_dispatch_identity_params[i][2], obs_source_get_id(source));
+	}
+}
+static void release_job(dispatch_job* job) {
+	for (obs_source_t*& ref : job->refs) {
+		obs_source_release(ref);
+		ref = nullptr;
+	}
+}
+static dispatch_job* peek_job() {
+	dispatch_job* job = &g_dispatch_jobs[g_dispatch_dequeue_pos & (DISPATCH_QUEUE_SIZE - 1)];
+	return job->sequence.load(memory_order_acquire) == g_dispatch_dequeue_pos + 1? job : nullptr;
+}
+static void pop_job(dispatch_job* job) {
+	release_job(job);
+	job->sequence.store(g_dispatch_dequeue_pos + DISPATCH_QUEUE_SIZE, memory_order_release);
+	g_dispatch_dequeue_pos++;
+	g_dispatch_finished.fetch_add(1, memory_order_relaxed);
+}
+static void* dispatch_thread(void*) {
+	os_set_thread_name("accessibility: dispatch");
+	while (os_event_wait(g_dispatch_wake) == 0 && g_dispatch_running) {
+		while (dispatch_job* job = peek_job()) {
+			if (job->earcon_only) play(job->event, job->timestamp, job->has_data? &job->data : nullptr);
+			else announce_event(job->event, job->has_data? &job->data : nullptr, job->prerendered, job->rule, job->timestamp);
+			pop_job(job);
+			if (!g_dispatch_running) break;
+		}
+		speak_scheduled_utterances();
+	}
+	return nullptr;
+}
+bool init_dispatch() {
+	if (g_dispatch_running) return true;
+	// The queue and wake event outlive shutdown_dispatch(), a producer that raced past the running check may still touch them.
+	if (!g_dispatch_jobs) g_dispatch_jobs = make_unique<dispatch_job[]>(DISPATCH_QUEUE_SIZE);
+	for (size_t i = 0; i < DISPATCH_QUEUE_SIZE; i++) g_dispatch_jobs[i].sequence.store(i, memory_order_relaxed);
+	g_dispatch_enqueue_pos = 0;
+	g_dispatch_dequeue_pos = 0;
+	if (!g_dispatch_wake && os_event_init(&g_dispatch_wake, OS_EVENT_TYPE_AUTO) != 0) return false;
+	g_dispatch_running = true;
+	if (pthread_create(&g_dispatch_thread, nullptr, dispatch_thread, nullptr) != 0) {
+		g_dispatch_running = false;
+		return false;
+	}
+	return true;
+}
+void shutdown_dispatch() {
+	if (!g_dispatch_running.exchange(false)) return;
+	os_event_signal(g_dispatch_wake);
+	pthread_join(g_dispatch_thread, nullptr);
+	while (dispatch_job* job = peek_job()) pop_job(job);
+	discard_scheduled_utterances();
+}
+void wake_dispatch() {
+	if (g_dispatch_running) os_event_signal(g_dispatch_wake);
+}
+bool dispatch_event(event_type* event, const calldata_t* data, bool prerendered, bool earcon_only) {
+	if (!g_dispatch_running) return false;
+	// Rules are checked against the caller's parameters, before a queue slot or any references are taken.
+	const event_rule* rule = match_event_rules(event->get_rules(), data);
+	if (rule && rule->action == EVENT_RULE_DROP) {
+		g_dispatch_filtered++;
+		return false;
+	}
+	size_t pos = g_dispatch_enqueue_pos.load(memory_order_relaxed);
+	dispatch_job* job;
+	for (;;) {
+		job = &g_dispatch_jobs[pos & (DISPATCH_QUEUE_SIZE - 1)];
+		intptr_t diff = (intptr_t)job->sequence.load(memory_order_acquire) - (intptr_t)pos;
+		if (diff == 0 && g_dispatch_enqueue_pos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) break;
+		else if (diff < 0) {
+			g_dispatch_dropped++;
+			return false;
+		} else if (diff > 0) pos = g_dispatch_enqueue_pos.load(memory_order_relaxed);
+	}
+	job->event = event;
+	job->prerendered = prerendered;
+	job->earcon_only = earcon_only;
+	job->rule = rule;
+	job->timestamp = os_gettime_ns();
+	copy_calldata(job, data);
+	job->sequence.store(pos + 1, memory_order_release);
+	g_dispatch_dispatched++;
+	os_event_signal(g_dispatch_wake);
+	return true;
+}
+dispatch_stats get_dispatch_stats() {
+	uint64_t finished = g_dispatch_finished.load(), dispatched = g_dispatch_dispatched.load();
+	return {dispatched, g_dispatch_dropped.load(), g_dispatch_filtered.load(), dispatched > finished? dispatched - finished : 0};
+}
@@ -0,0 +1,39 @@
+/*
+ OBS Accessibility
+ Copyright (C) 2025 Sam Tupy Productions <webmaster@samtupy.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along
+ with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#pragma once
+#include <cstdint>
+#include <obs.h>
+#include "events.h"
+
+#define DISPATCH_QUEUE_SIZE 512 // Must be a power of two.
+#define DISPATCH_CALLDATA_SIZE 512 // Bytes of signal parameters copied per queued event, larger calldata keeps only its source and filter.
+
+struct dispatch_stats {
+	uint64_t dispatched; // Events accepted onto the queue.
+	uint64_t dropped; // Events lost because the queue was full.
+	uint64_t filtered; // Events dropped by one of their rules.
+	uint64_t pending; // Events waiting for the dispatch thread.
+};
+
+// The dispatch thread plays earcons and speaks messages for events that were raised on other threads, see dispatch_event().
+bool init_dispatch();
+void shutdown_dispatch(); // Waits for the dispatch thread, events still queued are discarded.
+bool dispatch_event(event_type* event, const calldata_t* data, bool prerendered = false, bool earcon_only = false); // Safe from any thread and never allocates. Returns false if the event was dropped, by a full queue or by its rules. See announce_event() for prerendered, earcon_only only plays the event, see play().
+void wake_dispatch(); // Safe from any thread and never allocates, lets the dispatch thread speak utterances that were waiting on the mixer clock, see speak_scheduled_utterances().
+dispatch_stats get_dispatch_stats();
@@ -16,44 +16,109 @@
  with this program. If not, see <https://www.gnu.org/licenses/>
 */
 
+#include <algorithm>
+#include <deque>
 #include <exception>
+#include <mutex>
 #include <string>
 #include <unordered_map>
+#include <vector>
 #include <fmt/format.h>
 #include <obs.h>
+#include <obs-accessibility.h>
 #include <obs-frontend-api.h>
+#include <obs-module.h>
 #include <obs-source.h>
+#include <util/platform.h>
+#include <util/threading.h>
+#include "api.h"
 #include "audio.h"
 #include "config.h"
+#include "dispatch.h"
 #include "events.h"
+#include "history.h"
+#include "levels.h"
+#include "logs.h"
+#include "monitor.h"
+#include "rules.h"
+#include "scenes.h"
 #include "speech.h"
+#include "stream.h"
 #include "text.h"
+#include "video.h"
 
 using namespace std;
 using namespace fmt;
 
+struct event_id_hash {
+	// Lets g_event_types be searched with the signal name OBS hands us without first copying it into a string.
+	using is_transparent = void;
+	size_t operator()(std::string_view id) const { return hash<std::string_view>{}(id); }
+};
 unordered_map<obs_frontend_event, event_type*> g_frontend_event_types;
-unordered_map<string, event_type*> g_event_types;
-event_type::event_type(obs_frontend_event event, const std::string& id) : id(id), has_event(true), event(event) {
+unordered_map<string, event_type*, event_id_hash, equal_to<>> g_event_types;
+vector<event_type*> g_event_types_by_index; // Reserved with room for every custom type, so that adding one never moves the entries other threads are reading.
+atomic<size_t> g_event_type_count = 0; // Entries of g_event_types_by_index that are ready to be read.
+// Custom types live apart from g_event_types, which is only written before any signal can arrive.
+mutex g_custom_event_types_lock;
+unordered_map<string, event_type*, event_id_hash, equal_to<>> g_custom_event_types;
+atomic<bool> g_has_custom_event_types = false;
+// Events that are rarely worth hearing about while OBS is struggling, users can change this per event.
+const char* g_default_low_priority_events[] = {"source_update", "source_save", "source_load", "source_activate", "source_deactivate", "source_audio_activate", "source_audio_deactivate", "source_transition_video_stop", "hotkey_layout_change", "hotkey_register", "hotkey_unregister", nullptr};
+// Continuous controls sound their value as they move, pairs of event ID and tone.
+const char* g_default_event_tones[] = {"tbar_value_changed", "pitch {tbar} 0 1023", "source_volume", "pitch {source.volume%} 0 100", nullptr};
+atomic<bool> g_event_strings_interned = false; // Set once every event's translations are cached, from then on new event types cache theirs when created.
+event_type::event_type(obs_frontend_event event, const std::string& id) : id(id), index(g_event_types_by_index.size()), has_event(true), event(event), active(false), low_priority(false), rules(nullptr), custom(false) {
 	g_event_types[id] = this;
 	g_frontend_event_types[event] = this;
+	g_event_types_by_index.push_back(this);
+	if (g_event_strings_interned) intern_strings();
 }
-event_type::event_type(const std::string& id, const std::string& primary_data) : id(id), has_event(false), primary_data(primary_data) {
+event_type::event_type(const std::string& id, const std::string& primary_data) : id(id), index(g_event_types_by_index.size()), has_event(false), primary_data(primary_data), active(false), low_priority(false), rules(nullptr), custom(false) {
 	g_event_types[id] = this;
+	g_event_types_by_index.push_back(this);
+	if (g_event_strings_interned) intern_strings();
 }
-string event_type::get_id() const { return id; }
-string event_type::get_name() const { return _t(id + ".name", id); }
-string event_type::get_description() const { return _t(id + ".description", ""); }
-string event_type::get_default_message() const { return _t(id + ".message", ""); }
+event_type::event_type(const std::string& id, const std::string& name, const std::string& description, const std::string& default_message) : id(id), index(g_event_types_by_index.size()), has_event(false), active(false), low_priority(false), rules(nullptr), custom(true), name(name), description(description), default_message(default_message) {}
+void event_type::intern_strings() {
+	if (custom) return;
+	name = _t(id + ".name", id);
+	description = _t(id + ".description", "");
+	default_message = _t(id + ".message", "");
+}
+const string& event_type::get_id() const { return id; }
+size_t event_type::get_index() const { return index; }
+string event_type::get_name() const { return g_event_strings_interned || custom? name : _t(id + ".name", id); }
+string event_type::get_description() const { return g_event_strings_interned || custom? description : _t(id + ".description", ""); }
+string event_type::get_default_message() const { return g_event_strings_interned || custom? default_message : _t(id + ".message", ""); }
 string event_type::describe() const {
 	string desc = get_description();
 	if (!desc.empty()) desc = _t("column_join", "; ") + desc;
 	return get_name() + desc;
 }
 bool event_type::get_muted(obs_source_t* event_source) const { return get_event_bool(id, "muted", false, event_source); }
+bool event_type::get_low_priority() const {
+	bool default_value = false;
+	for (const char** i = g_default_low_priority_events; *i && !default_value; ++i) default_value = id == *i;
+	return get_event_bool(id, "low_priority", default_value);
+}
+event_timing event_type::get_timing() const {
+	string timing = get_event_string(id, "timing", "together");
+	if (timing == "after_earcon") return EVENT_TIMING_AFTER_EARCON;
+	if (timing == "earcon_when_busy") return EVENT_TIMING_EARCON_WHEN_BUSY;
+	return EVENT_TIMING_TOGETHER;
+}
 string event_type::get_message(obs_source_t* event_source) const { return get_event_string(id, "message", get_default_message(), event_source); }
+string event_type::get_tone(obs_source_t* event_source) const {
+	const char* default_value = "";
+	for (const char** i = g_default_event_tones; *i; i += 2) {
+		if (id == *i) default_value = i[1];
+	}
+	return get_event_string(id, "tone", default_value, event_source);
+}
 bool event_type::is_frontend_event() const { return has_event; }
 bool event_type::is_signal() const { return !has_event; }
+bool event_type::is_custom() const { return custom; }
 obs_frontend_event event_type::get_frontend_event() const {
 	if (!has_event) throw runtime_error(format("{} is not a frontend event", id));
 	return event;
@@ -62,21 +127,48 @@ string event_type::get_primary_data() const {
 	if (has_event) throw runtime_error(format("{} is not a signal", id));
 	return primary_data;
 }
+bool event_type::is_active() const { return active.load(memory_order_relaxed); }
+void event_type::set_active(bool active) { this->active.store(active, memory_order_relaxed); }
+bool event_type::is_low_priority() const { return low_priority.load(memory_order_relaxed); }
+void event_type::set_low_priority(bool low_priority) { this->low_priority.store(low_priority, memory_order_relaxed); }
+const event_rule_program* event_type::get_rules() const { return rules.load(memory_order_acquire); }
+void event_type::set_rules(const event_rule_program* rules) { this->rules.store(rules, memory_order_release); }
 event_type* get_event_type(obs_frontend_event event) {
-	if (!g_frontend_event_types.contains(event)) return nullptr;
-	return g_frontend_event_types[event];
+	auto it = g_frontend_event_types.find(event);
+	return it != g_frontend_event_types.end()? it->second : nullptr;
 }
 string get_event_type_id(obs_frontend_event event) {
 	event_type* e = get_event_type(event);
 	return e? e->get_id() : "";
 }
-event_type* get_event_type(const string& id) {
-	if (!g_event_types.contains(id)) return nullptr;
-	return g_event_types[id];
+event_type* get_event_type(std::string_view id, bool include_custom) {
+	auto it = g_event_types.find(id);
+	if (it != g_event_types.end()) return it->second;
+	if (!include_custom || !g_has_custom_event_types.load(memory_order_acquire)) return nullptr;
+	lock_guard<mutex> lock(g_custom_event_types_lock);
+	auto custom = g_custom_event_types.find(id);
+	return custom != g_custom_event_types.end()? custom->second : nullptr;
 }
+event_type* get_event_type(size_t index) { return index < g_event_type_count.load(memory_order_acquire)? g_event_types_by_index[index] : nullptr; }
+size_t get_event_type_count() { return g_event_type_count.load(memory_order_acquire); }
 void get_event_types(vector<string>& out_events) {
 	out_events.reserve(g_event_types.size());
 	for (auto i : g_event_types) out_events.push_back(i.first);
+	lock_guard<mutex> lock(g_custom_event_types_lock);
+	for (auto i : g_custom_event_types) out_events.push_back(i.first);
+}
+event_type* register_custom_event_type(const string& id, const string& name, const string& description, const string& default_message) {
+	if (id.empty() || g_event_types.contains(id)) return nullptr;
+	lock_guard<mutex> lock(g_custom_event_types_lock);
+	auto it = g_custom_event_types.find(id);
+	if (it != g_custom_event_types.end()) return it->second;
+	if (g_event_types_by_index.size() == g_event_types_by_index.capacity()) return nullptr;
+	event_type* event = new event_type(id, name.empty()? id : name, description, default_message);
+	g_event_types_by_index.push_back(event);
+	g_custom_event_types[id] = event;
+	g_event_type_count.store(g_event_types_by_index.size(), memory_order_release);
+	g_has_custom_event_types.store(true, memory_order_release);
+	return event;
 }
 void register_event_types() {
 	new event_type(OBS_FRONTEND_EVENT_STREAMING_STARTING, "streaming_starting");
@@ -140,7 +232,6 @@ void register_event_types() {
 	new event_type("source_transition_video_stop", "source");
 	new event_type("source_transition_stop", "source");
 	new event_type("channel_change", "source");
-	new event_type("channel_change", "source");
 	new event_type("hotkey_layout_change", "");
 	new event_type("hotkey_register", "hotkey");
 	new event_type("hotkey_unregister", "hotkey");
@@ -151,22 +242,278 @@ void register_event_types() {
 	new event_type("canvas_video_reset", "canvas");
 	new event_type("canvas_rename", "canvas");
 	new event_type("video_reset", "");
+	// Raised by the plugin itself rather than by OBS.
+	new event_type("load_shedding_start", "");
+	new event_type("load_shedding_stop", "");
+	new event_type("stream_health", "");
+	new event_type("record_health", "");
+	new event_type("system_stats", "");
+	new event_type("scene_items", "");
+	new event_type("preview_items", "");
+	new event_type("audio_clipping", "source");
+	new event_type("audio_silence", "source");
+	new event_type("audio_restored", "source");
+	new event_type("video_black", "");
+	new event_type("video_frozen", "");
+	new event_type("video_restored", "");
+	new event_type("log_reconnect", "");
+	new event_type("log_encoder_error", "");
+	new event_type("log_source_failed", "");
+	new event_type("log_match", "");
+	new event_type("log_error", "");
+	new event_type("script_announcement", "");
+	g_event_types_by_index.reserve(g_event_types_by_index.size() + EVENT_MAX_CUSTOM_TYPES);
+	g_event_type_count = g_event_types_by_index.size();
+}
+void intern_event_strings() {
+	for (size_t i = 0; i < get_event_type_count(); i++) g_event_types_by_index[i]->intern_strings();
+	g_event_strings_interned = true;
 }
 void unregister_event_types() {
-	for (auto i : g_event_types) delete i.second;
+	g_event_strings_interned = false;
+	g_event_type_count = 0;
+	g_has_custom_event_types = false;
+	for (event_type* i : g_event_types_by_index) delete i;
+	g_event_types_by_index.clear();
 	g_event_types.clear();
 	g_frontend_event_types.clear();
+	lock_guard<mutex> lock(g_custom_event_types_lock);
+	g_custom_event_types.clear();
 }
 
 bool g_receive_events = false; // Set to true when program finishes loading, false when we start to exit.
+
+// Hotkeys that announce a plugin event on demand, their messages read the monitor's cached statistics so a press is answered right away.
+const char* g_hotkey_events[] = {"stream_health", "record_health", "system_stats", "scene_items", "preview_items", nullptr};
+vector<obs_hotkey_id> g_event_hotkeys;
+void on_event_hotkey(void* data, obs_hotkey_id id, obs_hotkey_t* hotkey, bool pressed) {
+	event_type* event = static_cast<event_type*>(data);
+	if (!pressed || !g_receive_events || !event->is_active()) return;
+	dispatch_event(event, nullptr);
+}
+void register_event_hotkeys() {
+	OBSDataAutoRelease hotkeys = get_hotkeys_config();
+	for (int i = 0; g_hotkey_events[i]; i++) {
+		event_type* event = get_event_type(std::string_view(g_hotkey_events[i]));
+		if (!event) continue;
+		string name = format("announce_{}", event->get_id());
+		obs_hotkey_id id = obs_hotkey_register_frontend(name.c_str(), obs_module_text(format("hk.{}", name).c_str()), on_event_hotkey, event);
+		if (id == OBS_INVALID_HOTKEY_ID) continue;
+		if (hotkeys) {
+			OBSDataArrayAutoRelease binding = obs_data_get_array(hotkeys, name.c_str());
+			obs_hotkey_load(id, binding);
+		}
+		g_event_hotkeys.push_back(id);
+	}
+}
+void unregister_event_hotkeys() {
+	for (obs_hotkey_id id : g_event_hotkeys) obs_hotkey_unregister(id);
+	g_event_hotkeys.clear();
+}
+
+// Work that doesn't need to hold up obs_module_load runs here instead, and is waited for before the first event is announced.
+pthread_t g_startup_thread;
+bool g_startup_running = false;
+void* startup_thread(void* arg) {
+	os_set_thread_name("accessibility: startup");
+	uint64_t start = os_gettime_ns();
+	intern_event_strings();
+	refresh_event_cache();
+	preload_earcons();
+	set_speech_backend(get_property_string("speech_backend"));
+	set_load_shedding(get_property_bool("shed_load"), get_property_int("shed_cpu"));
+	set_level_sources(get_property_strings("level_sources"));
+	set_level_silence(get_property_int("level_silence_db"), get_property_int("level_silence_seconds"));
+	set_log_patterns(get_property_strings("log_patterns"));
+	set_video_monitor(get_property_bool("video_monitor"));
+	set_event_stream(get_property_bool("event_stream"));
+	set_earcon_latency(get_property_int("earcon_latency_ms"));
+	set_direct_output(get_property_bool("direct_output"), get_property_int("direct_output_period_ms"));
+#ifndef _WIN32
+	if (!init_speech()) obs_log(LOG_WARNING, "no speech backend available");
+#endif
+	obs_log(LOG_INFO, "background startup finished in %.1f ms", (os_gettime_ns() - start) / 1000000.0);
+	return nullptr;
+}
+void begin_startup() {
+	g_startup_running = pthread_create(&g_startup_thread, nullptr, startup_thread, nullptr) == 0;
+	if (!g_startup_running) startup_thread(nullptr);
+}
+void finish_startup() {
+	if (!g_startup_running) return;
+	pthread_join(g_startup_thread, nullptr);
+	g_startup_running = false;
+}
+// In studio mode the preview scene is picked well before the transition that puts it live, so the messages announced at that transition are rendered for it up front. When the preview does go live they are queued for the dispatch thread, which speaks them without any template work.
+const char* g_prerendered_event_ids[] = {"scene_changed", "transition_stopped", nullptr};
+struct prerendered_message {
+	event_type* event;
+	string text;
+};
+mutex g_prerendered_lock;
+obs_weak_source_t* g_prerendered_scene = nullptr; // The preview scene g_prerendered_messages were rendered for.
+uint64_t g_prerendered_generation = 0; // Scene mirror generation they were rendered at.
+vector<prerendered_message> g_prerendered_messages;
+vector<prerendered_message> g_prerendered_live; // Taken from g_prerendered_messages when their scene went live, waiting for the rest of the transition.
+deque<prerendered_message> g_prerendered_queue; // Handed to announce_event() in dispatch order.
+static void discard_prerendered_scene() {
+	// Call with g_prerendered_lock held.
+	obs_weak_source_release(g_prerendered_scene);
+	g_prerendered_scene = nullptr;
+	g_prerendered_messages.clear();
+}
+void discard_prerendered_messages() {
+	lock_guard<mutex> lock(g_prerendered_lock);
+	discard_prerendered_scene();
+	g_prerendered_live.clear();
+	g_prerendered_queue.clear();
+}
+static void prerender_preview_scene() {
+	OBSSourceAutoRelease scene = obs_frontend_preview_program_mode_active()? obs_frontend_get_current_preview_scene() : nullptr;
+	vector<prerendered_message> messages;
+	uint64_t generation = get_scene_mirror_generation();
+	for (int i = 0; scene && g_prerendered_event_ids[i]; i++) {
+		event_type* event = get_event_type(std::string_view(g_prerendered_event_ids[i]));
+		if (!event || !event->is_active()) continue;
+		// Only scene variables are covered by the scene mirror generation, a message that also mentions stats, the stream, the preview or the transition bar could be stale by the time it is spoken, so it is left for the dispatch thread.
+		string message = event->get_message();
+		if (uses_only_variables(message, "scene.")) messages.push_back({event, replace_obs_variables(message, nullptr, scene)});
+	}
+	lock_guard<mutex> lock(g_prerendered_lock);
+	discard_prerendered_scene();
+	if (!scene) return;
+	g_prerendered_scene = obs_source_get_weak_source(scene);
+	g_prerendered_generation = generation;
+	g_prerendered_messages.swap(messages);
+}
+static void confirm_prerendered_scene() {
+	// Called on the UI thread for every scene change, whether or not scene_changed itself is announced, since transition_stopped may still be.
+	lock_guard<mutex> lock(g_prerendered_lock);
+	g_prerendered_live.clear();
+	if (!g_prerendered_scene) return;
+	// A script can transition straight to a scene other than the preview, so one pointer comparison confirms the guess before it is used.
+	OBSSourceAutoRelease scene = obs_frontend_get_current_scene();
+	if (obs_weak_source_references_source(g_prerendered_scene, scene)) g_prerendered_live = g_prerendered_messages;
+}
+static bool queue_prerendered_message(event_type* event) {
+	// Called on the UI thread just before a scene_changed or transition_stopped event is dispatched, returns true if a message was queued for it.
+	lock_guard<mutex> lock(g_prerendered_lock);
+	if (get_scene_mirror_generation() != g_prerendered_generation) {
+		// Something the messages may mention changed since they were rendered.
+		discard_prerendered_scene();
+		g_prerendered_live.clear();
+		return false;
+	}
+	auto it = find_if(g_prerendered_live.begin(), g_prerendered_live.end(), [&](const prerendered_message& m) { return m.event == event; });
+	if (it == g_prerendered_live.end()) return false;
+	g_prerendered_queue.push_back(std::move(*it));
+	g_prerendered_live.erase(it);
+	return true;
+}
+static void unqueue_prerendered_message() {
+	// Undoes queue_prerendered_message() for an event the dispatch queue had no room for.
+	lock_guard<mutex> lock(g_prerendered_lock);
+	if (!g_prerendered_queue.empty()) g_prerendered_queue.pop_back();
+}
+static bool take_prerendered_message(event_type* event, string& text) {
+	lock_guard<mutex> lock(g_prerendered_lock);
+	if (g_prerendered_queue.empty() || g_prerendered_queue.front().event != event) return false;
+	text = std::move(g_prerendered_queue.front().text);
+	g_prerendered_queue.pop_front();
+	return true;
+}
+struct scheduled_utterance {
+	string text;
+	bool interrupt;
+	uint64_t frame; // Global source frame after which it is spoken.
+};
+deque<scheduled_utterance> g_scheduled_utterances; // Only touched by the dispatch thread.
+void speak_scheduled_utterances() {
+	uint64_t now = get_mixer_frame(); // A mixer that stopped running will never reach the frame, so everything left is spoken straight away.
+	while (!g_scheduled_utterances.empty() && (!now || g_scheduled_utterances.front().frame < now)) {
+		speak(g_scheduled_utterances.front().text, g_scheduled_utterances.front().interrupt);
+		g_scheduled_utterances.pop_front();
+	}
+	if (!g_scheduled_utterances.empty()) wake_dispatch_at_frame(g_scheduled_utterances.front().frame);
+}
+void discard_scheduled_utterances() {
+	g_scheduled_utterances.clear();
+}
+static void schedule_utterance(string&& text, bool interrupt, uint64_t frame) {
+	// Messages keep the order their events arrived in, so once one waits on its earcon everything after it waits behind it.
+	if (!g_scheduled_utterances.empty()) frame = max(frame, g_scheduled_utterances.back().frame);
+	if (!frame) {
+		speak(text, interrupt);
+		return;
+	}
+	g_scheduled_utterances.push_back({std::move(text), interrupt, frame});
+	speak_scheduled_utterances();
+}
+void announce_event(event_type* event, const calldata_t* data, bool prerendered, const event_rule* rule, uint64_t timestamp) {
+	event_timing timing = event->get_timing();
+	uint64_t earcon_end = 0;
+	play(event, timestamp, data, timing == EVENT_TIMING_AFTER_EARCON? &earcon_end : nullptr);
+	string text;
+	bool has_text = prerendered && take_prerendered_message(event, text); // Taken before anything can return early, so that the queue stays in step with the jobs.
+	bool speech = get_property_bool("speech");
+	if (!speech && !event_stream_active()) return; // Stream subscribers get the resolved message even when nothing is spoken.
+	if (rule && rule->action == EVENT_RULE_EARCON) text.clear();
+	else if (rule && rule->action == EVENT_RULE_SPEAK) text = replace_obs_variables(rule->message, data);
+	else if (!has_text) text = replace_obs_variables(event->get_message(), data);
+	void* source = nullptr;
+	if (data) calldata_get_ptr(data, "source", &source);
+	publish_event(event, text, (obs_source_t*)source);
+	if (!speech || text.empty()) return;
+	record_history(event, text);
+	if (timing == EVENT_TIMING_EARCON_WHEN_BUSY && (is_speech_busy() || !g_scheduled_utterances.empty())) return;
+	schedule_utterance(std::move(text), get_property_bool("speech_interrupt"), earcon_end);
+}
 void on_event(obs_frontend_event event, void*) {
 	switch (event) {
 		case OBS_FRONTEND_EVENT_FINISHED_LOADING:
+			finish_startup();
+#ifdef _WIN32
+			// Prism is set up only now, since pointing the process wide DLL search path at our bin directory while OBS loads other modules on the UI thread would change where their libraries come from.
+			if (!init_speech()) obs_log(LOG_WARNING, "no speech backend available");
+#endif
+			init_monitor();
+			init_video_monitor();
+			init_scene_mirror();
 			g_receive_events = true;
+			start_log_announcements();
+			start_api_announcements();
+			break;
+		case OBS_FRONTEND_EVENT_PREVIEW_SCENE_CHANGED:
+		case OBS_FRONTEND_EVENT_STUDIO_MODE_ENABLED:
+		case OBS_FRONTEND_EVENT_STUDIO_MODE_DISABLED:
+			if (g_receive_events) prerender_preview_scene();
+			break;
+		case OBS_FRONTEND_EVENT_SCENE_COLLECTION_CHANGING:
+		case OBS_FRONTEND_EVENT_SCENE_COLLECTION_CLEANUP:
+			clear_scene_mirror(); // Sources are about to be torn down by the thousand, better to rebuild once the new collection has loaded than to follow each one.
+			discard_prerendered_messages();
+			break;
+		case OBS_FRONTEND_EVENT_SCENE_COLLECTION_CHANGED:
+			if (g_receive_events) init_scene_mirror();
+			break;
+		case OBS_FRONTEND_EVENT_STREAMING_STARTING:
+		case OBS_FRONTEND_EVENT_STREAMING_STOPPED:
+		case OBS_FRONTEND_EVENT_RECORDING_STARTING:
+		case OBS_FRONTEND_EVENT_RECORDING_STOPPED:
+		case OBS_FRONTEND_EVENT_PROFILE_CHANGED:
+			if (g_receive_events) refresh_monitored_outputs(); // The frontend creates its outputs on demand and replaces them when settings change.
 			break;
 		case OBS_FRONTEND_EVENT_EXIT:
 		case OBS_FRONTEND_EVENT_SCRIPTING_SHUTDOWN:
 			g_receive_events = false;
+			stop_log_announcements();
+			stop_api_announcements();
+			shutdown_monitor();
+			shutdown_video_monitor();
+			clear_scene_mirror();
+			discard_prerendered_messages();
+			shutdown_dispatch(); // Nothing may still be playing through the global source once it goes away.
+			shutdown_event_stream();
 			save_config();
 			shutdown_audio();
 			break;
@@ -174,33 +521,53 @@ void on_event(obs_frontend_event event, void*) {
 			break;
 	}
 	if (!g_receive_events) return;
+	if (event == OBS_FRONTEND_EVENT_SCENE_CHANGED) confirm_prerendered_scene();
 	event_type* event_obj = get_event_type(event);
-	if (!event_obj) return;
-	play(event_obj->get_id());
-	if (!get_property_bool("speech")) return;
-	string text = replace_obs_variables(event_obj->get_message(), nullptr);
-	if (text.empty()) return;
-	speak(text, get_property_bool("speech_interrupt"));
+	if (!event_obj || !event_obj->is_active()) return;
+	if (event_obj->is_low_priority() && is_shedding_load()) {
+		count_shed_event();
+		return;
+	}
+	bool prerendered = (event == OBS_FRONTEND_EVENT_SCENE_CHANGED || event == OBS_FRONTEND_EVENT_TRANSITION_STOPPED) && queue_prerendered_message(event_obj);
+	if (!dispatch_event(event_obj, nullptr, prerendered) && prerendered) unqueue_prerendered_message();
 }
 void on_signal(void*, const char* signal_name, calldata_t* data) {
+	// This runs on whatever thread raised the signal, often a busy one, so everything past the lookup is handed to the dispatch thread without touching the heap.
 	if (!g_receive_events) return;
-	event_type* event_obj = get_event_type(signal_name);
-	if (!event_obj) return;
-	play(signal_name);
-	if (!get_property_bool("speech")) return;
-	string text = replace_obs_variables(event_obj->get_message(), data);
-	if (text.empty()) return;
-	speak(text, get_property_bool("speech_interrupt"));
+	event_type* event_obj = get_event_type(std::string_view(signal_name), false);
+	if (!event_obj || !event_obj->is_active()) return;
+	if (event_obj->is_low_priority() && is_shedding_load()) {
+		count_shed_event();
+		return;
+	}
+	dispatch_event(event_obj, data);
 }
 void init_events() {
 	register_event_types();
+	register_event_hotkeys();
+	init_dispatch();
+	init_levels();
+	init_log_watcher();
+	init_api();
 	signal_handler_t* core_handler = obs_get_signal_handler();
 	signal_handler_connect_global(core_handler, on_signal, nullptr);
 	obs_frontend_add_event_callback(on_event, nullptr);
+	begin_startup();
 }
 void shutdown_events() {
+	finish_startup();
 	signal_handler_t* core_handler = obs_get_signal_handler();
 	signal_handler_disconnect_global(core_handler, on_signal, nullptr);
 	obs_frontend_remove_event_callback(on_event, nullptr);
+	shutdown_monitor();
+	shutdown_video_monitor();
+	clear_scene_mirror();
+	shutdown_levels();
+	shutdown_log_watcher();
+	stop_api_announcements();
+	shutdown_dispatch();
+	shutdown_event_stream();
+	unregister_event_hotkeys();
 	unregister_event_types();
+	shutdown_event_rules();
 }
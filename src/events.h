@@ -17,36 +17,78 @@
 */
 
 #pragma once
+#include <atomic>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <obs-frontend-api.h>
 #include <obs-source.h>
 
+struct event_rule;
+struct event_rule_program;
+
+#define EVENT_MAX_CUSTOM_TYPES 64 // Event types scripts and other plugins can add at runtime, see register_custom_event_type().
+
+// How an event's message is spoken relative to its earcon, timed by the global source's mixer clock.
+enum event_timing {
+	EVENT_TIMING_TOGETHER, // Speech starts as the earcon does.
+	EVENT_TIMING_AFTER_EARCON, // Speech waits until the earcon has been mixed to its end.
+	EVENT_TIMING_EARCON_WHEN_BUSY, // The message is left unspoken, though still kept in history, when it would talk over speech already going.
+};
+
 // Describes a frontend event or signal we can listen for.
 class event_type {
 	std::string id;
+	size_t index;
 	bool has_event;
 	obs_frontend_event event;
 	std::string primary_data;
+	std::atomic<bool> active; // Cached by refresh_event_cache() so that the signal path can skip events with nothing to announce.
+	std::atomic<bool> low_priority; // Also cached by refresh_event_cache(), these are shed while OBS is overloaded.
+	std::atomic<const event_rule_program*> rules; // Compiled by refresh_event_rules(), see rules.h.
+	bool custom; // Added at runtime, its strings were given rather than translated.
+	std::string name, description, default_message; // Translations filled in by intern_event_strings().
+	void intern_strings();
+	friend void intern_event_strings();
 public:
 	event_type(obs_frontend_event event, const std::string& id);
 	event_type(const std::string& id, const std::string& primary_data);
-	std::string get_id() const;
+	event_type(const std::string& id, const std::string& name, const std::string& description, const std::string& default_message); // Custom, see register_custom_event_type().
+	const std::string& get_id() const;
+	size_t get_index() const; // Dense registration order, used to index per event caches.
 	std::string get_name() const; // translated id.name
 	std::string get_description() const; // translated id.description
 	std::string get_default_message() const; // translated id.message
 	std::string describe() const; // translated id.name; id.description
 	bool get_muted(obs_source_t* event_source = nullptr) const; // Returns true if user has muted earcons for this event.
+	bool get_low_priority() const; // Returns true if this event should be skipped while OBS is under heavy load, either by default or as configured.
+	event_timing get_timing() const;
 	std::string get_message(obs_source_t* event_source = nullptr) const; // Gets either the configured or default spoken message for this event.
+	std::string get_tone(obs_source_t* event_source = nullptr) const; // Gets either the configured or default value tone for this event, see tones.h.
 	bool is_frontend_event() const;
 	bool is_signal() const;
+	bool is_custom() const;
 	obs_frontend_event get_frontend_event() const; // Throws exception if not a frontend event.
 	std::string get_primary_data() const; // Throws exception if no primary signal data.
+	bool is_active() const; // Returns true if any event source has an earcon for this event or it has a message to speak.
+	void set_active(bool active);
+	bool is_low_priority() const; // Cached get_low_priority().
+	void set_low_priority(bool low_priority);
+	const event_rule_program* get_rules() const; // Null when the event has no rules.
+	void set_rules(const event_rule_program* rules);
 };
 event_type* get_event_type(obs_frontend_event event);
 std::string get_event_type_id(obs_frontend_event event);
-event_type* get_event_type(const std::string& id);
+event_type* get_event_type(std::string_view id, bool include_custom = true); // Custom types can never be OBS signals, so the signal path leaves them out.
+event_type* get_event_type(size_t index);
+size_t get_event_type_count();
 void get_event_types(std::vector<std::string>& out_events);
+event_type* register_custom_event_type(const std::string& id, const std::string& name, const std::string& description, const std::string& default_message); // Safe from any thread. Returns the existing type if the ID was already registered this way, or null if it belongs to a built in event or EVENT_MAX_CUSTOM_TYPES are taken.
+void announce_event(event_type* event, const calldata_t* data, bool prerendered = false, const event_rule* rule = nullptr, uint64_t timestamp = 0); // Plays and speaks an event, called from the dispatch thread. A prerendered event speaks the next message queued for it when it was dispatched instead of rendering its own, rule is the one of its rules that matched, if any, and timestamp is when the event arrived, see play().
+void speak_scheduled_utterances(); // Speaks messages whose earcon the mixer has finished, called by the dispatch thread each time it wakes.
+void discard_scheduled_utterances(); // Drops messages still waiting on their earcon, call only while the dispatch thread is stopped.
+void discard_prerendered_messages(); // Drops messages rendered ahead of time for the studio mode preview scene, call whenever event messages may have changed.
+void intern_event_strings(); // Translates every event's name, description and default message once, rather than on each lookup.
 
-void init_events(); // Registers event types and listeners, call once on module load.
+void init_events(); // Registers event types and listeners and starts the background startup task, call once on module load.
 void shutdown_events(); // Disconnects event listeners, call once on module unload.
@@ -0,0 +1,134 @@
+/*
+ OBS Accessibility
+ Copyright (C) 2025 Sam Tupy Productions <webmaster@samtupy.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along
+ with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <ctime>
+#include <fmt/format.h>
+#include <obs-module.h>
+#include <util/platform.h>
+#include "history.h"
+#include "speech.h"
+#include "text.h"
+
+using namespace std;
+using namespace fmt;
+
+// Each slot is published with its own sequence lock like the monitor's snapshot, so a reader copying a slot that is being rewritten sees the count change and retries rather than returning a torn message.
+struct history_slot {
+	atomic<uint64_t> sequence;
+	uint64_t index;
+	const event_type* event;
+	uint64_t timestamp;
+	uint32_t length;
+	char text[HISTORY_TEXT_SIZE];
+};
+history_slot g_history[HISTORY_SIZE] = {};
+atomic<uint64_t> g_history_end = 0;
+uint64_t g_history_review = 0; // Index of the message the hotkeys last read out, only touched from the hotkey thread.
+
+void record_history(const event_type* event, const string& text) {
+	uint64_t index = g_history_end.fetch_add(1, memory_order_relaxed); // Claimed up front, a reader that gets to the slot before it is written sees the old index and skips it.
+	history_slot& slot = g_history[index & (HISTORY_SIZE - 1)];
+	size_t length = min(text.size(), size_t(HISTORY_TEXT_SIZE));
+	while (length < text.size() && length && (text[length] & 0xc0) == 0x80) length--; // Never split a UTF-8 sequence.
+	uint64_t sequence = slot.sequence.load(memory_order_relaxed);
+	slot.sequence.store(sequence + 1, memory_order_relaxed);
+	atomic_thread_fence(memory_order_release);
+	slot.index = index;
+	slot.event = event;
+	slot.timestamp = chrono::duration_cast<chrono::nanoseconds>(chrono::system_clock::now().time_since_epoch()).count();
+	slot.length = uint32_t(length);
+	memcpy(slot.text, text.data(), length);
+	slot.sequence.store(sequence + 2, memory_order_release);
+}
+uint64_t get_history_end() { return g_history_end.load(memory_order_acquire); }
+bool get_history_entry(uint64_t index, history_entry& out) {
+	if (index >= get_history_end()) return false;
+	const history_slot& slot = g_history[index & (HISTORY_SIZE - 1)];
+	const event_type* event;
+	uint64_t sequence, slot_index, timestamp;
+	uint32_t length;
+	char text[HISTORY_TEXT_SIZE];
+	do {
+		sequence = slot.sequence.load(memory_order_acquire);
+		slot_index = slot.index;
+		event = slot.event;
+		timestamp = slot.timestamp;
+		length = min(slot.length, uint32_t(HISTORY_TEXT_SIZE));
+		memcpy(text, slot.text, length);
+		atomic_thread_fence(memory_order_acquire);
+	} while ((sequence & 1) || sequence != slot.sequence.load(memory_order_relaxed));
+	if (slot_index != index) return false;
+	out.index = index;
+	out.event_id = event? event->get_id() : "";
+	out.timestamp = timestamp;
+	out.text.assign(text, length);
+	return true;
+}
+string format_history() {
+	string output;
+	history_entry entry;
+	uint64_t end = get_history_end();
+	for (uint64_t i = end > HISTORY_SIZE? end - HISTORY_SIZE : 0; i < end; i++) {
+		if (!get_history_entry(i, entry)) continue;
+		time_t seconds = time_t(entry.timestamp / 1000000000);
+		tm local = {};
+#ifdef _WIN32
+		localtime_s(&local, &seconds);
+#else
+		localtime_r(&seconds, &local);
+#endif
+		char when[32];
+		strftime(when, sizeof(when), "%Y-%m-%d %H:%M:%S", &local);
+		output += format("{}\t{}\t{}\n", when, entry.event_id, entry.text);
+	}
+	return output;
+}
+bool export_history(const string& path) {
+	string text = format_history();
+	return os_quick_write_utf8_file_safe(path.c_str(), text.c_str(), text.size(), false, ".tmp", nullptr);
+}
+void review_history(int direction) {
+	uint64_t end = get_history_end();
+	if (!end) {
+		speak(_t("history.empty"), true);
+		return;
+	}
+	uint64_t oldest = end > HISTORY_SIZE? end - HISTORY_SIZE : 0;
+	if (direction == 0 || g_history_review < oldest || g_history_review >= end) g_history_review = end - 1;
+	else if (direction < 0 && g_history_review == oldest) {
+		speak(_t("history.start"), true);
+		return;
+	} else if (direction > 0 && g_history_review == end - 1) {
+		speak(_t("history.end"), true);
+		return;
+	} else g_history_review += direction < 0? -1 : 1;
+	history_entry entry;
+	if (get_history_entry(g_history_review, entry)) speak(entry.text, true);
+}
+void export_history_announced() {
+	char* config_dir = obs_module_config_path(nullptr);
+	if (config_dir) os_mkdirs(config_dir);
+	bfree(config_dir);
+	char* file = obs_module_config_path("history.txt");
+	bool success = file && export_history(file);
+	speak(success? format(runtime(_t("history.exported")), get_history_end() > HISTORY_SIZE? HISTORY_SIZE : get_history_end()) : _t("history.export_failed"), true);
+	bfree(file);
+}
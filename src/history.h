@@ -0,0 +1,43 @@
+/*
+ OBS Accessibility
+ Copyright (C) 2025 Sam Tupy Productions <webmaster@samtupy.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along
+ with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#pragma once
+#include <cstdint>
+#include <string>
+#include "events.h"
+
+#define HISTORY_SIZE 256 // Messages kept, must be a power of two.
+#define HISTORY_TEXT_SIZE 512 // Bytes kept per message, longer ones are cut at a character boundary.
+
+struct history_entry {
+	uint64_t index; // Counts every message ever recorded, so it stays meaningful as the ring wraps.
+	std::string event_id;
+	uint64_t timestamp; // Wall clock nanoseconds since the epoch.
+	std::string text;
+};
+
+// Every message spoken for an event is kept in a ring of preallocated slots, so that announcements cut short by newer ones or lost in a burst can be reviewed.
+void record_history(const event_type* event, const std::string& text); // Safe from any thread, never blocks or allocates.
+uint64_t get_history_end(); // One past the index of the newest message.
+bool get_history_entry(uint64_t index, history_entry& out); // Never blocks, returns false if that message was never recorded or has since been overwritten.
+std::string format_history(); // Every message still kept, oldest first, one per line.
+bool export_history(const std::string& path);
+
+// Used by the review hotkeys, which OBS runs one at a time on its hotkey thread.
+void review_history(int direction); // 0 repeats the newest message, -1 and 1 step back and forward from the last one reviewed.
+void export_history_announced(); // Writes history.txt next to the plugin's config and says whether that worked.
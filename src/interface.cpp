@@ -35,10 +35,12 @@
 #include <QObject>
 #include <QPushButton>
 #include <QSpinBox>
+#include <QTimer>
 #include <QVBoxLayout>
 #include <QWidget>
 #include "audio.h" // get_audio_event_source()
 #include "config.h"
+#include "history.h"
 #include "interface.h"
 #include "speech.h"
 #include "text.h"
@@ -57,6 +59,15 @@ void correct_properties_focus() {
 // Experimintal QT event handler and related helper functions which try to make various interfaces more accessible, these are hacks that should really be implemented properly into obs.
 qt_event_filter* g_qt_filter = nullptr;
 void fix_property_controls(QFormLayout* layout);
+QLabel* get_property_label(QWidget* label_widget) {
+	QLabel* label = label_widget? qobject_cast<QLabel*>(label_widget) : nullptr;
+	if (label_widget && !label) {
+		// Usually this means that a label was provided, but a tooltip was provided as well. When this happens the label widget turns into a layout with the actual text we're interested in provided in the first sub widget in this layout.
+		QHBoxLayout* lbl_layout = qobject_cast<QHBoxLayout*>(label_widget->layout());
+		if (lbl_layout && lbl_layout->count() > 0) label = qobject_cast<QLabel*>(lbl_layout->itemAt(0)->widget());
+	}
+	return label;
+}
 void fix_property_editable_list_buttons(QVBoxLayout* buttons) {
 	// Editable lists create 5 unlabeled buttons. In order they are add, remove, edit, move up, and move down.
 	if (!buttons || buttons->count() < 5) return;
@@ -66,13 +77,7 @@ void fix_property_editable_list_buttons(QVBoxLayout* buttons) {
 		if (btn) btn->setAccessibleName(obs_module_text(button_names[i]));
 	}
 }
-void fix_property_control(QWidget* control, QLayout* layout, QWidget* label_widget = nullptr) {
-	QLabel* label = label_widget? qobject_cast<QLabel*>(label_widget) : nullptr;
-	if (label_widget && !label) {
-		// Usually this means that a label was provided, but a tooltip was provided as well. When this happens the label widget turns into a layout with the actual text we're interested in provided in the first sub widget in this layout.
-		QHBoxLayout* lbl_layout = qobject_cast<QHBoxLayout*>(label_widget->layout());
-		if (lbl_layout) label = qobject_cast<QLabel*>(lbl_layout->itemAt(0)->widget());
-	}
+void fix_property_control(QWidget* control, QLayout* layout, QLabel* label = nullptr) {
 	if (control) {
 		QString name = control->accessibleName();
 		QGroupBox* group = qobject_cast<QGroupBox*>(control);
@@ -106,7 +111,7 @@ void fix_property_controls(QFormLayout* layout) {
 		QWidget* w = layout->itemAt(i)->widget();
 		QLayout* l = layout->itemAt(i)->layout();
 		QWidget* lbl_widget = w? layout->labelForField(w) : layout->labelForField(l);
-		fix_property_control(w, l, lbl_widget);
+		fix_property_control(w, l, get_property_label(lbl_widget));
 	}
 }
 void fix_filters_dialog(QDialog* dlg) {	
@@ -137,25 +142,58 @@ void fix_filters_dialog(QDialog* dlg) {
 		filter_item->setData(Qt::AccessibleTextRole, filter_label->text());
 	}
 }
+filters_dialog_watcher::filters_dialog_watcher(QDialog* dialog) : QObject(dialog), dialog(dialog), pending(false) {
+	watch_list(dialog->findChild<QListWidget*>("asyncFilters"));
+	watch_list(dialog->findChild<QListWidget*>("effectFilters"));
+	schedule_fix();
+}
+void filters_dialog_watcher::watch_list(QListWidget* list) {
+	// Filters are added, removed, reordered and renamed through the list models, and their checkbox rows arrive as new children of the viewport after the row itself.
+	if (!list) return;
+	QAbstractItemModel* model = list->model();
+	auto schedule = [this] { schedule_fix(); };
+	connect(model, &QAbstractItemModel::rowsInserted, this, schedule);
+	connect(model, &QAbstractItemModel::rowsRemoved, this, schedule);
+	connect(model, &QAbstractItemModel::rowsMoved, this, schedule);
+	connect(model, &QAbstractItemModel::modelReset, this, schedule);
+	connect(model, &QAbstractItemModel::layoutChanged, this, schedule);
+	connect(model, &QAbstractItemModel::dataChanged, this, schedule);
+	list->viewport()->installEventFilter(this);
+}
+void filters_dialog_watcher::schedule_fix() {
+	if (pending) return;
+	pending = true;
+	QTimer::singleShot(0, this, [this] {
+		pending = false;
+		fix_filters_dialog(dialog);
+	});
+}
+bool filters_dialog_watcher::eventFilter(QObject* watched, QEvent* event) {
+	if (event->type() == QEvent::ChildAdded) schedule_fix();
+	return false;
+}
 qt_event_filter::qt_event_filter(QObject* parent, bool debug) : QObject(parent), debug(debug) {}
 bool qt_event_filter::eventFilter(QObject* watched, QEvent* event) {
-	if (event->type() == QEvent::Timer) return false;
-	if (debug) {
+	QEvent::Type type = event->type();
+	if (debug && type != QEvent::Timer) {
 		speak(QDebug::toString(event).toStdString());
 		return false;
 	}
+	// Every event of every widget passes through here, so anything we don't handle must leave before the first cast.
+	if (type != QEvent::WindowActivate && type != QEvent::Show && type != QEvent::ParentChange) return false;
 	QWidget* widget = qobject_cast<QWidget*>(watched);
-	if (event->type() == QEvent::WindowActivate) {
+	if (!widget) return false;
+	if (type == QEvent::WindowActivate) {
 		QPushButton* btn = qobject_cast<QPushButton*>(widget);
 		if (btn && btn->isDefault()) g_last_default_button = btn;
-	} else if (event->type() == QEvent::Paint) {
-		// Todo: Find a better event that fires far less but still enough.
-		QDialog* dlg = qobject_cast<QDialog*>(widget);
-		if (dlg && dlg->objectName() == "OBSBasicFilters") fix_filters_dialog(dlg);
-	} else if (event->type() == QEvent::ParentChange) {
+	} else if (type == QEvent::Show) {
+		QDialog* dlg = widget->isWindow()? qobject_cast<QDialog*>(widget) : nullptr;
+		if (dlg && dlg->objectName() == "OBSBasicFilters" && !dlg->findChild<filters_dialog_watcher*>(QString(), Qt::FindDirectChildrenOnly)) new filters_dialog_watcher(dlg);
+	} else if (type == QEvent::ParentChange) {
 		if (watched->objectName() == "PropertiesContainer") {
 			QFormLayout* layout = qobject_cast<QFormLayout*>(widget->layout());
 			if (!layout) return false;
+			// OBS builds a new container with new rows on every refresh, so each one is labeled exactly once here.
 			fix_property_controls(layout);
 		}
 	}
@@ -183,17 +221,32 @@ bool on_hk_window_show(void* data, obs_hotkey_pair_id id, obs_hotkey_t *hotkey,
 	win->setWindowState((win->windowState() & ~Qt::WindowMinimized) | Qt::WindowActive);
 	return true;
 }
+void on_hk_history_repeat(void* data, obs_hotkey_id id, obs_hotkey_t* hotkey, bool pressed) {
+	if (pressed) review_history(0);
+}
+bool on_hk_history_previous(void* data, obs_hotkey_pair_id id, obs_hotkey_t* hotkey, bool pressed) {
+	if (pressed) review_history(-1);
+	return false; // Neither key of the pair ever switches the pair's state.
+}
+bool on_hk_history_next(void* data, obs_hotkey_pair_id id, obs_hotkey_t* hotkey, bool pressed) {
+	if (pressed) review_history(1);
+	return false;
+}
+void on_hk_history_export(void* data, obs_hotkey_id id, obs_hotkey_t* hotkey, bool pressed) {
+	if (pressed) export_history_announced();
+}
 void on_hotkey_bindings_changed(void* param, calldata_t* data) {
 	// Save hotkey binding changes for our global custom keys, is this the best way to do it, maybe make even the global keys use the source system instead?
 	obs_hotkey_t* hotkey = static_cast<obs_hotkey_t*>(calldata_ptr(data, "key"));
 	if (!hotkey) return;
 	string hk_name = obs_hotkey_get_name(hotkey);
-	if (hk_name == "window_show" || hk_name == "window_hide") {
+	if (hk_name == "window_show" || hk_name == "window_hide" || hk_name.starts_with("announce_") || hk_name.starts_with("history_")) {
 		OBSDataAutoRelease hotkeys = get_hotkeys_config();
 		if (!hotkeys) return;
 		OBSDataArrayAutoRelease binding = obs_hotkey_save(obs_hotkey_get_id(hotkey));
 		if (binding) obs_data_set_array(hotkeys, obs_hotkey_get_name(hotkey), binding);
 		else obs_data_erase(hotkeys, obs_hotkey_get_name(hotkey));
+		mark_config_dirty();
 	}
 	QMainWindow* win = static_cast<QMainWindow*>(obs_frontend_get_main_window());
 	win->menuBar()->setNativeMenuBar(true);
@@ -206,6 +259,15 @@ void init_interface() {
 		OBSDataArrayAutoRelease b0 = obs_data_get_array(hotkeys, "window_hide"), b1 = obs_data_get_array(hotkeys, "window_show");
 		obs_hotkey_pair_load(hk_window_vis, b0, b1);
 	}
+	obs_hotkey_id hk_history_repeat = obs_hotkey_register_frontend("history_repeat", obs_module_text("hk_history_repeat"), on_hk_history_repeat, nullptr);
+	obs_hotkey_pair_id hk_history_review = obs_hotkey_pair_register_frontend("history_previous", obs_module_text("hk_history_previous"), "history_next", obs_module_text("hk_history_next"), on_hk_history_previous, on_hk_history_next, nullptr, nullptr);
+	obs_hotkey_id hk_history_export = obs_hotkey_register_frontend("history_export", obs_module_text("hk_history_export"), on_hk_history_export, nullptr);
+	if (hotkeys) {
+		OBSDataArrayAutoRelease repeat = obs_data_get_array(hotkeys, "history_repeat"), previous = obs_data_get_array(hotkeys, "history_previous"), next = obs_data_get_array(hotkeys, "history_next"), exported = obs_data_get_array(hotkeys, "history_export");
+		obs_hotkey_load(hk_history_repeat, repeat);
+		obs_hotkey_pair_load(hk_history_review, previous, next);
+		obs_hotkey_load(hk_history_export, exported);
+	}
 	signal_handler_t* core_handler = obs_get_signal_handler();
 	signal_handler_connect(core_handler, "hotkey_bindings_changed", on_hotkey_bindings_changed, nullptr);
 	QCoreApplication* app = QCoreApplication::instance();
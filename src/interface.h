@@ -20,8 +20,11 @@
 #include <string>
 #include <QtCore/QEvent>
 #include <QtCore/QObject>
+class QDialog;
+class QListWidget;
 class QListWidgetItem;
 
+// Installed on the whole application, so it only looks at the few event types that tell us a window worth fixing has appeared.
 class qt_event_filter : public QObject {
 	Q_OBJECT
 	bool debug;
@@ -30,6 +33,18 @@ public:
 protected:
 	bool eventFilter(QObject* watched, QEvent* event) override;
 };
+// Attached to each filters dialog, reruns fix_filters_dialog at most once per event loop turn when its lists change.
+class filters_dialog_watcher : public QObject {
+	Q_OBJECT
+	QDialog* dialog;
+	bool pending;
+	void watch_list(QListWidget* list);
+public:
+	filters_dialog_watcher(QDialog* dialog);
+	void schedule_fix();
+protected:
+	bool eventFilter(QObject* watched, QEvent* event) override;
+};
 
 void init_interface();
 void shutdown_interface();
@@ -0,0 +1,238 @@
+/*
+ OBS Accessibility
+ Copyright (C) 2025 Sam Tupy Productions <webmaster@samtupy.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along
+ with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <memory>
+#include <mutex>
+#include <obs.h>
+#include <obs.hpp>
+#include "dispatch.h"
+#include "events.h"
+#include "levels.h"
+#include "monitor.h"
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#include <emmintrin.h>
+	#define LEVELS_SSE2
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+	#include <arm_neon.h>
+	#define LEVELS_NEON
+#endif
+
+using namespace std;
+
+static void measure_plane(const float* samples, size_t frames, float& peak, double& sum) {
+	// Two independent accumulators of four lanes each, so the loop isn't bound by the latency of a single max or add chain.
+	size_t i = 0;
+	float plane_peak = 0.0f, plane_sum = 0.0f;
+	#if defined(LEVELS_SSE2)
+		const __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+		__m128 peak0 = _mm_setzero_ps(), peak1 = _mm_setzero_ps(), sum0 = _mm_setzero_ps(), sum1 = _mm_setzero_ps();
+		for (; i + 8 <= frames; i += 8) {
+			__m128 a = _mm_loadu_ps(samples + i), b = _mm_loadu_ps(samples + i + 4);
+			peak0 = _mm_max_ps(peak0, _mm_and_ps(a, abs_mask));
+			peak1 = _mm_max_ps(peak1, _mm_and_ps(b, abs_mask));
+			sum0 = _mm_add_ps(sum0, _mm_mul_ps(a, a));
+			sum1 = _mm_add_ps(sum1, _mm_mul_ps(b, b));
+		}
+		float lanes_peak[4], lanes_sum[4];
+		_mm_storeu_ps(lanes_peak, _mm_max_ps(peak0, peak1));
+		_mm_storeu_ps(lanes_sum, _mm_add_ps(sum0, sum1));
+		plane_peak = max(max(lanes_peak[0], lanes_peak[1]), max(lanes_peak[2], lanes_peak[3]));
+		plane_sum = (lanes_sum[0] + lanes_sum[1]) + (lanes_sum[2] + lanes_sum[3]);
+	#elif defined(LEVELS_NEON)
+		float32x4_t peak0 = vdupq_n_f32(0.0f), peak1 = vdupq_n_f32(0.0f), sum0 = vdupq_n_f32(0.0f), sum1 = vdupq_n_f32(0.0f);
+		for (; i + 8 <= frames; i += 8) {
+			float32x4_t a = vld1q_f32(samples + i), b = vld1q_f32(samples + i + 4);
+			peak0 = vmaxq_f32(peak0, vabsq_f32(a));
+			peak1 = vmaxq_f32(peak1, vabsq_f32(b));
+			sum0 = vfmaq_f32(sum0, a, a);
+			sum1 = vfmaq_f32(sum1, b, b);
+		}
+		plane_peak = vmaxvq_f32(vmaxq_f32(peak0, peak1));
+		plane_sum = vaddvq_f32(vaddq_f32(sum0, sum1));
+	#endif
+	for (; i < frames; i++) {
+		plane_peak = max(plane_peak, fabsf(samples[i]));
+		plane_sum += samples[i] * samples[i];
+	}
+	peak = max(peak, plane_peak);
+	sum += plane_sum;
+}
+audio_levels measure_audio_levels(const float* const* planes, size_t channels, size_t frames) {
+	float peak = 0.0f;
+	double sum = 0.0;
+	size_t measured = 0;
+	for (size_t c = 0; c < channels; c++) {
+		if (!planes[c]) continue;
+		measure_plane(planes[c], frames, peak, sum);
+		measured++;
+	}
+	return {peak, measured && frames? float(sqrt(sum / (measured * frames))) : 0.0f};
+}
+
+// One per chosen source name. Everything below source is only touched by the audio thread while the capture callback is registered.
+struct level_watcher {
+	string name;
+	obs_source_t* source; // Not referenced, so that watching a source never keeps it alive, cleared by on_level_source_destroy.
+	uint64_t clip_frames, since_clip_frames, since_clip_announce_frames, silent_frames;
+	bool silence_announced;
+};
+recursive_mutex g_levels_lock; // Guards g_level_watchers and each watcher's name and source, recursive because releasing a source while holding it can raise source_destroy.
+vector<unique_ptr<level_watcher>> g_level_watchers;
+atomic<event_type*> g_level_clipping_event = nullptr, g_level_silence_event = nullptr, g_level_restored_event = nullptr;
+atomic<uint32_t> g_level_sample_rate = 48000;
+atomic<float> g_level_silence_threshold = 0.001f; // -60 dBFS
+atomic<double> g_level_silence_seconds = 10.0;
+static void announce_level_event(const atomic<event_type*>& event_ptr, obs_source_t* source) {
+	// Runs on the audio thread, so the calldata lives on the stack and dispatch_event copies it.
+	event_type* event = event_ptr.load(memory_order_acquire);
+	if (!event || !event->is_active()) return;
+	if (event->is_low_priority() && is_shedding_load()) {
+		count_shed_event();
+		return;
+	}
+	uint8_t stack[128];
+	calldata_t data;
+	calldata_init_fixed(&data, stack, sizeof(stack));
+	calldata_set_ptr(&data, "source", source);
+	dispatch_event(event, &data);
+}
+static void on_level_audio(void* param, obs_source_t* source, const struct audio_data* audio, bool muted) {
+	level_watcher* w = static_cast<level_watcher*>(param);
+	if (!audio || !audio->frames) return;
+	uint64_t rate = g_level_sample_rate.load(memory_order_relaxed);
+	audio_levels levels = {};
+	if (!muted) {
+		audio_t* output = obs_get_audio();
+		size_t channels = output? min<size_t>(audio_output_get_channels(output), MAX_AV_PLANES) : 2;
+		levels = measure_audio_levels(reinterpret_cast<const float* const*>(audio->data), channels, audio->frames);
+	}
+	// Clipping, announced once enough clipped blocks arrive close together and not again until LEVEL_CLIP_REPEAT_MS has passed.
+	w->since_clip_announce_frames += audio->frames;
+	if (levels.peak >= LEVEL_CLIP_THRESHOLD) {
+		w->clip_frames += audio->frames;
+		w->since_clip_frames = 0;
+	} else if ((w->since_clip_frames += audio->frames) >= rate * LEVEL_CLIP_RELEASE_MS / 1000) w->clip_frames = 0;
+	if (w->clip_frames >= rate * LEVEL_CLIP_MS / 1000 && w->since_clip_announce_frames >= rate * LEVEL_CLIP_REPEAT_MS / 1000) {
+		w->clip_frames = 0;
+		w->since_clip_announce_frames = 0;
+		announce_level_event(g_level_clipping_event, source);
+	}
+	// Dead air, muted counts as silent since the audience hears nothing either way.
+	if (muted || levels.rms < g_level_silence_threshold.load(memory_order_relaxed)) {
+		w->silent_frames += audio->frames;
+		if (!w->silence_announced && w->silent_frames >= uint64_t(rate * g_level_silence_seconds.load(memory_order_relaxed))) {
+			w->silence_announced = true;
+			announce_level_event(g_level_silence_event, source);
+		}
+	} else {
+		w->silent_frames = 0;
+		if (w->silence_announced) {
+			w->silence_announced = false;
+			announce_level_event(g_level_restored_event, source);
+		}
+	}
+}
+static void attach_watcher(level_watcher* w, obs_source_t* source) {
+	// Call with g_levels_lock held.
+	if (w->source || !source) return;
+	w->source = source;
+	w->clip_frames = w->since_clip_frames = w->silent_frames = 0;
+	w->since_clip_announce_frames = UINT64_MAX / 2;
+	w->silence_announced = false;
+	obs_source_add_audio_capture_callback(source, on_level_audio, w);
+}
+static void detach_watcher(level_watcher* w) {
+	// Call with g_levels_lock held. Once removal returns OBS will not call on_level_audio for this watcher again.
+	if (!w->source) return;
+	obs_source_remove_audio_capture_callback(w->source, on_level_audio, w);
+	w->source = nullptr;
+}
+static void attach_by_name(level_watcher* w) {
+	OBSSourceAutoRelease source = obs_get_source_by_name(w->name.c_str());
+	attach_watcher(w, source);
+}
+static void on_level_source_create(void*, calldata_t* data) {
+	obs_source_t* source = static_cast<obs_source_t*>(calldata_ptr(data, "source"));
+	const char* name = source? obs_source_get_name(source) : nullptr;
+	if (!name) return;
+	lock_guard<recursive_mutex> lock(g_levels_lock);
+	for (auto& w : g_level_watchers) {
+		if (!w->source && w->name == name) attach_watcher(w.get(), source);
+	}
+}
+static void on_level_source_destroy(void*, calldata_t* data) {
+	obs_source_t* source = static_cast<obs_source_t*>(calldata_ptr(data, "source"));
+	lock_guard<recursive_mutex> lock(g_levels_lock);
+	for (auto& w : g_level_watchers) {
+		if (w->source == source) detach_watcher(w.get());
+	}
+}
+static void on_level_source_rename(void*, calldata_t* data) {
+	// Sources are chosen by name, so a renamed source stops being watched and one renamed to a chosen name starts.
+	obs_source_t* source = static_cast<obs_source_t*>(calldata_ptr(data, "source"));
+	const char* new_name = calldata_string(data, "new_name");
+	lock_guard<recursive_mutex> lock(g_levels_lock);
+	for (auto& w : g_level_watchers) {
+		if (w->source == source && (!new_name || w->name != new_name)) detach_watcher(w.get());
+		else if (!w->source && new_name && w->name == new_name) attach_watcher(w.get(), source);
+	}
+}
+void set_level_sources(const vector<string>& names) {
+	lock_guard<recursive_mutex> lock(g_levels_lock);
+	auto removed = remove_if(g_level_watchers.begin(), g_level_watchers.end(), [&](const unique_ptr<level_watcher>& w) { return find(names.begin(), names.end(), w->name) == names.end(); });
+	for (auto it = removed; it != g_level_watchers.end(); ++it) detach_watcher(it->get());
+	g_level_watchers.erase(removed, g_level_watchers.end());
+	for (const string& name : names) {
+		if (name.empty() || any_of(g_level_watchers.begin(), g_level_watchers.end(), [&](const unique_ptr<level_watcher>& w) { return w->name == name; })) continue;
+		g_level_watchers.push_back(make_unique<level_watcher>(level_watcher{name, nullptr, 0, 0, 0, 0, false}));
+		attach_by_name(g_level_watchers.back().get());
+	}
+}
+void set_level_silence(double threshold_db, double seconds) {
+	g_level_silence_threshold = float(pow(10.0, threshold_db / 20.0));
+	g_level_silence_seconds = seconds;
+}
+void init_levels() {
+	audio_t* output = obs_get_audio();
+	if (output) g_level_sample_rate = audio_output_get_sample_rate(output);
+	g_level_clipping_event = get_event_type(std::string_view("audio_clipping"));
+	g_level_silence_event = get_event_type(std::string_view("audio_silence"));
+	g_level_restored_event = get_event_type(std::string_view("audio_restored"));
+	signal_handler_t* core_handler = obs_get_signal_handler();
+	signal_handler_connect(core_handler, "source_create", on_level_source_create, nullptr);
+	signal_handler_connect(core_handler, "source_destroy", on_level_source_destroy, nullptr);
+	signal_handler_connect(core_handler, "source_rename", on_level_source_rename, nullptr);
+	lock_guard<recursive_mutex> lock(g_levels_lock);
+	for (auto& w : g_level_watchers) attach_by_name(w.get());
+}
+void shutdown_levels() {
+	signal_handler_t* core_handler = obs_get_signal_handler();
+	signal_handler_disconnect(core_handler, "source_create", on_level_source_create, nullptr);
+	signal_handler_disconnect(core_handler, "source_destroy", on_level_source_destroy, nullptr);
+	signal_handler_disconnect(core_handler, "source_rename", on_level_source_rename, nullptr);
+	{
+		lock_guard<recursive_mutex> lock(g_levels_lock);
+		for (auto& w : g_level_watchers) detach_watcher(w.get());
+	}
+	g_level_clipping_event = nullptr;
+	g_level_silence_event = nullptr;
+	g_level_restored_event = nullptr;
+}
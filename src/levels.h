@@ -0,0 +1,41 @@
+/*
+ OBS Accessibility
+ Copyright (C) 2025 Sam Tupy Productions <webmaster@samtupy.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along
+ with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#define LEVEL_CLIP_THRESHOLD 0.989f // Peak sample magnitude that counts as clipping, about -0.1 dBFS.
+#define LEVEL_CLIP_MS 200 // Clipped audio needed before clipping is announced, gaps shorter than LEVEL_CLIP_RELEASE_MS don't reset it.
+#define LEVEL_CLIP_RELEASE_MS 500
+#define LEVEL_CLIP_REPEAT_MS 10000 // Minimum time between two clipping announcements for the same source.
+
+struct audio_levels {
+	float peak; // Largest sample magnitude across all channels.
+	float rms; // Root mean square across all channels.
+};
+
+// Measures one block of planar float audio with SSE2 or NEON where available, cheap enough to run on the audio thread for every block.
+audio_levels measure_audio_levels(const float* const* planes, size_t channels, size_t frames);
+
+// Sources chosen by name have their audio measured as it passes through OBS, announcing sustained clipping, dead air and its end.
+void init_levels(); // Call after the event types are registered.
+void shutdown_levels(); // Call before the event types are unregistered.
+void set_level_sources(const std::vector<std::string>& names); // Sources that don't exist yet are picked up when they are created.
+void set_level_silence(double threshold_db, double seconds); // Quieter than threshold_db for this long, or muted, counts as dead air.
@@ -0,0 +1,287 @@
+/*
+ OBS Accessibility
+ Copyright (C) 2025 Sam Tupy Productions <webmaster@samtupy.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along
+ with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <obs.h>
+#include <util/base.h>
+#include <util/platform.h>
+#include "obs-accessibility.h"
+#include "dispatch.h"
+#include "events.h"
+#include "logs.h"
+#include "monitor.h"
+
+using namespace std;
+
+// Each kind of log announcement has its own event, and holds on to the first line that matched it while OBS was still loading.
+struct log_event_slot {
+	const char* id;
+	atomic<event_type*> event;
+	atomic<int> held; // 0 when empty, 1 while a line is being copied in, 2 once it is waiting for start_log_announcements().
+	char line[LOG_WATCH_MESSAGE_SIZE];
+};
+enum log_event_kind { LOG_EVENT_RECONNECT, LOG_EVENT_ENCODER_ERROR, LOG_EVENT_SOURCE_FAILED, LOG_EVENT_MATCH, LOG_EVENT_ERROR, LOG_EVENT_COUNT };
+log_event_slot g_log_events[LOG_EVENT_COUNT] = {{"log_reconnect"}, {"log_encoder_error"}, {"log_source_failed"}, {"log_match"}, {"log_error"}};
+struct builtin_log_pattern {
+	const char* text;
+	log_event_kind kind;
+};
+// Text libobs and the bundled plugins log for the failures an operator most needs to hear about.
+const builtin_log_pattern g_builtin_log_patterns[] = {
+	{"': Reconnecting in", LOG_EVENT_RECONNECT},
+	{"Error encoding with encoder", LOG_EVENT_ENCODER_ERROR},
+	{"Source ID '", LOG_EVENT_SOURCE_FAILED},
+	{"Failed to open media", LOG_EVENT_SOURCE_FAILED},
+	{"failed to load texture", LOG_EVENT_SOURCE_FAILED},
+};
+
+struct log_pattern {
+	string text;
+	log_event_kind kind;
+};
+// A dense Aho-Corasick automaton over byte classes, so that scanning a line costs two table lookups per byte whatever the number of patterns.
+struct log_matcher {
+	vector<log_pattern> patterns;
+	uint8_t columns[256]; // Column per byte, 0 for bytes that appear in no pattern. ASCII letters share a column with their other case.
+	uint32_t column_count;
+	vector<uint32_t> next; // next[state + column], where a state is its row's offset into this table, with failure links already folded in.
+	vector<int32_t> match; // Pattern found on reaching each state, itself or through one of its suffixes, or -1, indexed by state / column_count.
+	uint32_t first_match; // States are numbered so that every one which finds a pattern comes at or after this, one comparison per byte tells whether to stop.
+	unique_ptr<atomic<uint64_t>[]> last; // os_gettime_ns() of each pattern's last announcement.
+};
+atomic<const log_matcher*> g_log_matcher = nullptr;
+mutex g_log_matchers_lock; // Guards the lists below, never taken by the log handler.
+vector<unique_ptr<log_matcher>> g_log_matchers; // Never freed while the module is loaded, not even by shutdown_log_watcher(), a logging thread may still be scanning with a replaced one.
+vector<string> g_log_user_patterns;
+atomic<uint64_t> g_log_error_last = 0;
+atomic<bool> g_log_live = false;
+log_handler_t g_log_previous_handler = nullptr;
+void* g_log_previous_param = nullptr;
+char g_log_own_prefix[64]; // Lines this plugin logs itself are never matched.
+size_t g_log_own_prefix_length = 0;
+
+static unique_ptr<log_matcher> build_log_matcher(const vector<log_pattern>& patterns) {
+	unique_ptr<log_matcher> m = make_unique<log_matcher>();
+	for (const log_pattern& pattern : patterns) {
+		if (!pattern.text.empty()) m->patterns.push_back(pattern);
+	}
+	memset(m->columns, 0, sizeof(m->columns));
+	m->column_count = 1;
+	for (const log_pattern& pattern : m->patterns) {
+		for (unsigned char c : pattern.text) {
+			unsigned char lower = c >= 'A' && c <= 'Z'? c + 32 : c;
+			if (!m->columns[lower]) m->columns[lower] = m->column_count++;
+		}
+	}
+	for (int c = 'A'; c <= 'Z'; c++) m->columns[c] = m->columns[c + 32];
+	// The trie comes first, with 0 standing in for a missing edge as nothing ever leads back to the root.
+	m->next.assign(m->column_count, 0);
+	m->match.assign(1, -1);
+	for (size_t i = 0; i < m->patterns.size(); i++) {
+		uint32_t state = 0;
+		for (unsigned char c : m->patterns[i].text) {
+			size_t edge = state * m->column_count + m->columns[c];
+			if (!m->next[edge]) {
+				m->next[edge] = uint32_t(m->match.size());
+				m->next.resize(m->next.size() + m->column_count, 0);
+				m->match.push_back(-1);
+			}
+			state = m->next[edge];
+		}
+		if (m->match[state] < 0) m->match[state] = int32_t(i);
+	}
+	// Breadth first, so that each missing edge can borrow the edge of its failure state, which is shallower and so already complete.
+	vector<uint32_t> fail(m->match.size(), 0);
+	deque<uint32_t> queue;
+	for (uint32_t column = 0; column < m->column_count; column++) {
+		if (m->next[column]) queue.push_back(m->next[column]);
+	}
+	while (!queue.empty()) {
+		uint32_t state = queue.front();
+		queue.pop_front();
+		if (m->match[state] < 0) m->match[state] = m->match[fail[state]];
+		for (uint32_t column = 0; column < m->column_count; column++) {
+			uint32_t& edge = m->next[state * m->column_count + column];
+			uint32_t fallback = m->next[fail[state] * m->column_count + column];
+			if (!edge) edge = fallback;
+			else {
+				fail[edge] = fallback;
+				queue.push_back(edge);
+			}
+		}
+	}
+	// Renumbered so that states which find a pattern come last, and stored as row offsets so that scanning never multiplies.
+	uint32_t state_count = uint32_t(m->match.size()), column_count = m->column_count;
+	vector<uint32_t> renumbered(state_count);
+	uint32_t next_number = 0;
+	for (uint32_t state = 0; state < state_count; state++) {
+		if (m->match[state] < 0) renumbered[state] = next_number++;
+	}
+	m->first_match = next_number * column_count;
+	for (uint32_t state = 0; state < state_count; state++) {
+		if (m->match[state] >= 0) renumbered[state] = next_number++;
+	}
+	vector<uint32_t> next(m->next.size());
+	vector<int32_t> match(state_count);
+	for (uint32_t state = 0; state < state_count; state++) {
+		match[renumbered[state]] = m->match[state];
+		for (uint32_t column = 0; column < column_count; column++) next[renumbered[state] * column_count + column] = renumbered[m->next[state * column_count + column]] * column_count;
+	}
+	m->next.swap(next);
+	m->match.swap(match);
+	m->last = make_unique<atomic<uint64_t>[]>(m->patterns.size());
+	return m;
+}
+static int run_log_matcher(const log_matcher* m, const char* line, size_t length) {
+	const uint32_t* next = m->next.data();
+	const uint8_t* columns = m->columns;
+	uint32_t state = 0, first_match = m->first_match;
+	for (size_t i = 0; i < length; i++) {
+		state = next[state + columns[(unsigned char)line[i]]];
+		if (state >= first_match) return m->match[state / m->column_count];
+	}
+	return -1;
+}
+static void publish_log_matcher() {
+	// Call with g_log_matchers_lock held.
+	vector<log_pattern> patterns;
+	for (const builtin_log_pattern& pattern : g_builtin_log_patterns) patterns.push_back({pattern.text, pattern.kind});
+	for (const string& pattern : g_log_user_patterns) patterns.push_back({pattern, LOG_EVENT_MATCH});
+	g_log_matchers.push_back(build_log_matcher(patterns));
+	g_log_matcher.store(g_log_matchers.back().get(), memory_order_release);
+}
+static size_t copy_log_line(char* out, const char* line, size_t length) {
+	length = min(length, size_t(LOG_WATCH_MESSAGE_SIZE - 1));
+	while (length && (line[length] & 0xc0) == 0x80) length--; // Never split a UTF-8 sequence.
+	memcpy(out, line, length);
+	out[length] = '\0';
+	return length;
+}
+static void announce_log_line(event_type* event, const char* line) {
+	uint8_t stack[LOG_WATCH_MESSAGE_SIZE + 64];
+	calldata_t data;
+	calldata_init_fixed(&data, stack, sizeof(stack));
+	calldata_set_string(&data, "line", line);
+	dispatch_event(event, &data);
+}
+static void watch_log_line(int level, const char* format, va_list args) {
+	// Runs on whichever thread logged the line, so it never allocates: the line is formatted on the stack and the matcher and announcement state are preallocated.
+	const log_matcher* m = g_log_matcher.load(memory_order_acquire);
+	if (!m || !strncmp(format, g_log_own_prefix, g_log_own_prefix_length)) return;
+	char line[LOG_WATCH_LINE_SIZE];
+	int formatted = vsnprintf(line, sizeof(line), format, args);
+	if (formatted <= 0) return;
+	size_t length = min(size_t(formatted), sizeof(line) - 1);
+	int index = run_log_matcher(m, line, length);
+	log_event_slot* slot;
+	atomic<uint64_t>* last;
+	if (index >= 0) {
+		slot = &g_log_events[m->patterns[index].kind];
+		last = &m->last[index];
+	} else if (level == LOG_ERROR) {
+		slot = &g_log_events[LOG_EVENT_ERROR];
+		last = &g_log_error_last;
+	} else return;
+	event_type* event = slot->event.load(memory_order_acquire);
+	if (!event || !event->is_active()) return;
+	uint64_t now = os_gettime_ns(), previous = last->load(memory_order_relaxed);
+	if (previous && now - previous < LOG_WATCH_REPEAT_MS * 1000000ULL) return;
+	if (!last->compare_exchange_strong(previous, now, memory_order_relaxed)) return; // Another thread is announcing the same thing.
+	if (!g_log_live.load(memory_order_acquire)) {
+		int empty = 0;
+		if (!slot->held.compare_exchange_strong(empty, 1, memory_order_acquire)) return;
+		copy_log_line(slot->line, line, length);
+		slot->held.store(2, memory_order_release);
+		return;
+	}
+	if (event->is_low_priority() && is_shedding_load()) {
+		count_shed_event();
+		return;
+	}
+	char message[LOG_WATCH_MESSAGE_SIZE];
+	copy_log_line(message, line, length);
+	announce_log_line(event, message);
+}
+static void log_handler(int level, const char* format, va_list args, void* param) {
+	// Debug lines are never matched, OBS logs far too many of them for formatting each one to be worthwhile.
+	if (level <= LOG_INFO && format) {
+		va_list copy;
+		va_copy(copy, args);
+		watch_log_line(level, format, copy);
+		va_end(copy);
+	}
+	if (g_log_previous_handler) g_log_previous_handler(level, format, args, g_log_previous_param);
+}
+
+void init_log_watcher() {
+	if (g_log_previous_handler) return;
+	g_log_own_prefix_length = size_t(snprintf(g_log_own_prefix, sizeof(g_log_own_prefix), "[%s]", PLUGIN_NAME));
+	g_log_own_prefix_length = min(g_log_own_prefix_length, sizeof(g_log_own_prefix) - 1);
+	for (log_event_slot& slot : g_log_events) slot.event.store(get_event_type(slot.id), memory_order_release);
+	{
+		lock_guard<mutex> lock(g_log_matchers_lock);
+		publish_log_matcher();
+	}
+	base_get_log_handler(&g_log_previous_handler, &g_log_previous_param);
+	base_set_log_handler(log_handler, nullptr);
+}
+void shutdown_log_watcher() {
+	if (!g_log_previous_handler) return;
+	// Always put the previous handler back so nothing in libobs can call into us after unload, even if that drops a handler chained after ours.
+	log_handler_t handler = nullptr;
+	void* param = nullptr;
+	base_get_log_handler(&handler, &param);
+	base_set_log_handler(g_log_previous_handler, g_log_previous_param);
+	g_log_live = false;
+	g_log_matcher.store(nullptr, memory_order_release);
+	for (log_event_slot& slot : g_log_events) {
+		slot.event.store(nullptr, memory_order_release);
+		slot.held.store(0, memory_order_relaxed);
+	}
+	g_log_previous_handler = nullptr;
+	if (handler != log_handler) obs_log(LOG_WARNING, "another log handler was installed after the log watcher and has been removed with it");
+}
+void start_log_announcements() {
+	g_log_live.store(true, memory_order_release);
+	for (log_event_slot& slot : g_log_events) {
+		if (slot.held.load(memory_order_acquire) != 2) continue;
+		event_type* event = slot.event.load(memory_order_acquire);
+		if (event) announce_log_line(event, slot.line);
+		slot.held.store(0, memory_order_release);
+	}
+}
+void stop_log_announcements() {
+	g_log_live.store(false, memory_order_release);
+}
+void set_log_patterns(const vector<string>& patterns) {
+	lock_guard<mutex> lock(g_log_matchers_lock);
+	if (patterns == g_log_user_patterns) return;
+	g_log_user_patterns = patterns;
+	if (g_log_matcher.load(memory_order_relaxed)) publish_log_matcher();
+}
+int match_log_line(const char* line, size_t length) {
+	const log_matcher* m = g_log_matcher.load(memory_order_acquire);
+	return m? run_log_matcher(m, line, length) : -1;
+}
@@ -0,0 +1,34 @@
+/*
+ OBS Accessibility
+ Copyright (C) 2025 Sam Tupy Productions <webmaster@samtupy.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along
+ with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#define LOG_WATCH_LINE_SIZE 1024 // Bytes of each formatted line that are matched, the rest is ignored.
+#define LOG_WATCH_MESSAGE_SIZE 256 // Bytes of a matching line passed on as the line variable.
+#define LOG_WATCH_REPEAT_MS 10000 // Minimum time between two announcements for the same pattern.
+
+// Chains into the libobs log handler and announces lines containing any of a set of patterns, such as reconnecting outputs, encoder errors and sources that failed to load, and error level lines that match none of them. Patterns are found with a single Aho-Corasick pass over each line, ignoring ASCII case.
+void init_log_watcher(); // Call after the event types are registered.
+void shutdown_log_watcher(); // Call before the event types are unregistered.
+void start_log_announcements(); // Matches before this, while OBS is loading, are held back and announced now, at most one per pattern.
+void stop_log_announcements();
+void set_log_patterns(const std::vector<std::string>& patterns); // Announced as log_match, in addition to the built in patterns.
+int match_log_line(const char* line, size_t length); // Index of the first pattern found, or -1. Exposed for the benchmark.
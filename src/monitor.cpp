@@ -0,0 +1,195 @@
+/*
+ OBS Accessibility
+ Copyright (C) 2025 Sam Tupy Productions <webmaster@samtupy.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along
+ with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#include <atomic>
+#include <mutex>
+#include <obs.h>
+#include <obs.hpp>
+#include <obs-frontend-api.h>
+#include <util/platform.h>
+#include <util/threading.h>
+#include "dispatch.h"
+#include "events.h"
+#include "monitor.h"
+
+using namespace std;
+
+atomic<bool> g_monitor_running = false;
+os_event_t* g_monitor_stop = nullptr;
+pthread_t g_monitor_thread;
+os_cpu_usage_info_t* g_monitor_cpu = nullptr;
+atomic<bool> g_shedding_enabled = true;
+atomic<double> g_shedding_cpu_threshold = 90.0;
+atomic<bool> g_shedding = false;
+atomic<uint64_t> g_shed_events = 0;
+// Counters as of the previous sample, only touched by whoever calls monitor_tick.
+uint32_t g_monitor_total_frames = 0, g_monitor_lagged_frames = 0, g_monitor_skipped_frames = 0, g_monitor_video_frames = 0;
+int g_monitor_output_frames[2] = {0, 0}, g_monitor_output_dropped[2] = {0, 0};
+uint64_t g_monitor_output_bytes[2] = {0, 0}, g_monitor_output_started[2] = {0, 0}, g_monitor_last_sample = 0;
+int g_monitor_overloaded_samples = 0, g_monitor_healthy_samples = 0;
+double frame_fraction(uint32_t part, uint32_t& last_part, uint32_t total, uint32_t& last_total) {
+	// Counters are deltas since the last sample, and start over if OBS reset them.
+	uint32_t frames = total >= last_total? total - last_total : total;
+	uint32_t parts = part >= last_part? part - last_part : part;
+	last_part = part;
+	last_total = total;
+	return frames? double(parts) / frames : 0.0;
+}
+// The snapshot is published with a sequence lock, readers retry while the count is odd or changed under them so that neither side ever blocks.
+atomic<uint32_t> g_stats_sequence = 0;
+obs_stats g_stats = {};
+void publish_obs_stats(const obs_stats& stats) {
+	uint32_t sequence = g_stats_sequence.load(memory_order_relaxed);
+	g_stats_sequence.store(sequence + 1, memory_order_relaxed);
+	atomic_thread_fence(memory_order_release);
+	g_stats = stats;
+	g_stats_sequence.store(sequence + 2, memory_order_release);
+}
+obs_stats get_obs_stats() {
+	obs_stats stats;
+	uint32_t sequence;
+	do {
+		sequence = g_stats_sequence.load(memory_order_acquire);
+		stats = g_stats;
+		atomic_thread_fence(memory_order_acquire);
+	} while ((sequence & 1) || sequence != g_stats_sequence.load(memory_order_relaxed));
+	return stats;
+}
+// The frontend only hands out its outputs on the UI thread, so weak references to them are taken there and the monitor thread samples those.
+mutex g_monitor_outputs_lock;
+obs_weak_output_t* g_monitor_outputs[2] = {nullptr, nullptr}; // Streaming and recording.
+static void set_monitored_outputs(obs_weak_output_t* streaming, obs_weak_output_t* recording) {
+	lock_guard<mutex> lock(g_monitor_outputs_lock);
+	obs_weak_output_release(g_monitor_outputs[0]);
+	obs_weak_output_release(g_monitor_outputs[1]);
+	g_monitor_outputs[0] = streaming;
+	g_monitor_outputs[1] = recording;
+}
+void refresh_monitored_outputs() {
+	OBSOutputAutoRelease streaming = obs_frontend_get_streaming_output();
+	OBSOutputAutoRelease recording = obs_frontend_get_recording_output();
+	set_monitored_outputs(obs_output_get_weak_output(streaming), obs_output_get_weak_output(recording));
+}
+static obs_output_t* get_monitored_output(int index) {
+	lock_guard<mutex> lock(g_monitor_outputs_lock);
+	return obs_weak_output_get_output(g_monitor_outputs[index]);
+}
+double sample_outputs(obs_stats& stats, uint64_t now, uint64_t elapsed_ns) {
+	// Fills in the stream and recording figures and returns the fraction of their frames dropped since the last sample.
+	int frames = 0, dropped = 0;
+	for (int i = 0; i < 2; i++) {
+		OBSOutputAutoRelease output = get_monitored_output(i);
+		bool active = output && obs_output_active(output);
+		int total = active? obs_output_get_total_frames(output) : 0;
+		int lost = active? obs_output_get_frames_dropped(output) : 0;
+		uint64_t bytes = active? obs_output_get_total_bytes(output) : 0;
+		frames += total >= g_monitor_output_frames[i]? total - g_monitor_output_frames[i] : total;
+		dropped += lost >= g_monitor_output_dropped[i]? lost - g_monitor_output_dropped[i] : lost;
+		double kbps = elapsed_ns && bytes >= g_monitor_output_bytes[i]? (bytes - g_monitor_output_bytes[i]) * 8.0 / 1000.0 / (elapsed_ns / 1000000000.0) : 0.0;
+		if (!active) g_monitor_output_started[i] = 0;
+		else if (!g_monitor_output_started[i]) g_monitor_output_started[i] = now;
+		uint64_t duration = active? now - g_monitor_output_started[i] : 0;
+		g_monitor_output_frames[i] = total;
+		g_monitor_output_dropped[i] = lost;
+		g_monitor_output_bytes[i] = bytes;
+		if (i == 0) {
+			stats.streaming = active;
+			stats.stream_reconnecting = active && obs_output_reconnecting(output);
+			stats.stream_kbps = kbps;
+			stats.stream_frames = total;
+			stats.stream_dropped = lost;
+			stats.stream_congestion = active? obs_output_get_congestion(output) : 0.0;
+			stats.stream_duration_ns = duration;
+		} else {
+			stats.recording = active;
+			stats.record_kbps = kbps;
+			stats.record_bytes = bytes;
+			stats.record_duration_ns = duration;
+		}
+	}
+	return frames > 0? double(dropped) / frames : 0.0;
+}
+void announce_load_event(const char* id) {
+	event_type* event = get_event_type(id);
+	if (event && event->is_active()) dispatch_event(event, nullptr);
+}
+load_sample monitor_tick() {
+	// Not safe to call from two threads at once, callers other than the monitor thread must shut it down first.
+	load_sample sample = {};
+	obs_stats stats = {};
+	uint64_t now = os_gettime_ns();
+	stats.timestamp = now;
+	sample.cpu = g_monitor_cpu? os_cpu_usage_info_query(g_monitor_cpu) : 0.0;
+	sample.render_lag = frame_fraction(obs_get_lagged_frames(), g_monitor_lagged_frames, obs_get_total_frames(), g_monitor_total_frames);
+	video_t* video = obs_get_video();
+	if (video) sample.skipped = frame_fraction(video_output_get_skipped_frames(video), g_monitor_skipped_frames, video_output_get_total_frames(video), g_monitor_video_frames);
+	sample.dropped = sample_outputs(stats, now, g_monitor_last_sample? now - g_monitor_last_sample : 0);
+	g_monitor_last_sample = now;
+	stats.cpu = sample.cpu;
+	stats.memory = os_get_proc_resident_size();
+	stats.fps = obs_get_active_fps();
+	stats.frame_time_ms = obs_get_average_frame_time_ns() / 1000000.0;
+	stats.render_lag = sample.render_lag;
+	publish_obs_stats(stats);
+	sample.overloaded = sample.cpu >= g_shedding_cpu_threshold || sample.render_lag >= MONITOR_LAG_THRESHOLD || sample.skipped >= MONITOR_LAG_THRESHOLD || sample.dropped >= MONITOR_DROP_THRESHOLD;
+	// Hysteresis, so that a machine hovering around a threshold doesn't flip back and forth every second.
+	g_monitor_overloaded_samples = sample.overloaded? g_monitor_overloaded_samples + 1 : 0;
+	g_monitor_healthy_samples = sample.overloaded? 0 : g_monitor_healthy_samples + 1;
+	if (!g_shedding && g_shedding_enabled && g_monitor_overloaded_samples >= MONITOR_SHED_AFTER) {
+		g_shedding = true;
+		announce_load_event("load_shedding_start");
+	} else if (g_shedding && (!g_shedding_enabled || g_monitor_healthy_samples >= MONITOR_RECOVER_AFTER)) {
+		g_shedding = false;
+		announce_load_event("load_shedding_stop");
+	}
+	return sample;
+}
+void* monitor_thread(void* arg) {
+	os_set_thread_name("accessibility: monitor");
+	while (g_monitor_running && os_event_timedwait(g_monitor_stop, MONITOR_INTERVAL_MS) != 0) monitor_tick();
+	return nullptr;
+}
+bool init_monitor() {
+	if (g_monitor_running) return true;
+	if (!g_monitor_stop && os_event_init(&g_monitor_stop, OS_EVENT_TYPE_MANUAL) != 0) return false;
+	os_event_reset(g_monitor_stop);
+	if (!g_monitor_cpu) g_monitor_cpu = os_cpu_usage_info_start();
+	refresh_monitored_outputs();
+	g_monitor_running = true;
+	if (pthread_create(&g_monitor_thread, nullptr, monitor_thread, nullptr) != 0) {
+		g_monitor_running = false;
+		return false;
+	}
+	return true;
+}
+void shutdown_monitor() {
+	if (!g_monitor_running.exchange(false)) return;
+	os_event_signal(g_monitor_stop);
+	pthread_join(g_monitor_thread, nullptr);
+	os_cpu_usage_info_destroy(g_monitor_cpu);
+	g_monitor_cpu = nullptr;
+	set_monitored_outputs(nullptr, nullptr);
+	g_shedding = false;
+}
+void set_load_shedding(bool enabled, double cpu_threshold) {
+	g_shedding_enabled = enabled;
+	g_shedding_cpu_threshold = cpu_threshold;
+}
+bool is_shedding_load() { return g_shedding.load(memory_order_relaxed); }
+uint64_t get_shed_event_count() { return g_shed_events; }
+void count_shed_event() { g_shed_events.fetch_add(1, memory_order_relaxed); }
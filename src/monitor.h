@@ -0,0 +1,58 @@
+/*
+ OBS Accessibility
+ Copyright (C) 2025 Sam Tupy Productions <webmaster@samtupy.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along
+ with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#pragma once
+#include <cstdint>
+
+#define MONITOR_INTERVAL_MS 1000
+#define MONITOR_LAG_THRESHOLD 0.05 // Fraction of frames rendered late or skipped within one interval that counts as overloaded.
+#define MONITOR_DROP_THRESHOLD 0.01 // Fraction of streaming and recording frames dropped within one interval that counts as overloaded.
+#define MONITOR_SHED_AFTER 2 // Consecutive overloaded samples before low priority events are shed.
+#define MONITOR_RECOVER_AFTER 5 // Consecutive healthy samples before they are announced again.
+
+struct load_sample {
+	double cpu; // Percent of the whole machine used by OBS.
+	double render_lag; // Fractions of the frames within the interval, see the thresholds above.
+	double skipped;
+	double dropped;
+	bool overloaded;
+};
+
+// Stream, recording and system figures as of the last sample, read by hotkeys and the {stream.*}, {record.*} and {stats.*} template variables.
+struct obs_stats {
+	uint64_t timestamp; // os_gettime_ns() when sampled, 0 until the monitor has run once.
+	bool streaming, stream_reconnecting, recording;
+	double stream_kbps, record_kbps; // Averaged over the last interval.
+	int stream_frames, stream_dropped; // Totals since the stream started.
+	double stream_congestion; // Between 0 and 1.
+	uint64_t stream_duration_ns, record_duration_ns, record_bytes;
+	double cpu; // Percent of the whole machine used by OBS.
+	uint64_t memory; // Resident bytes.
+	double fps, frame_time_ms, render_lag; // Render lag is the fraction of frames lagged within the interval.
+};
+
+// A background thread samples OBS health every MONITOR_INTERVAL_MS and decides whether events marked low priority should be shed.
+bool init_monitor(); // Call from the UI thread, as with refresh_monitored_outputs().
+void shutdown_monitor();
+void refresh_monitored_outputs(); // Call from the UI thread whenever the frontend may have created or replaced its streaming or recording output.
+load_sample monitor_tick(); // Takes one sample and updates the shedding state, the monitor thread calls this on its own.
+void set_load_shedding(bool enabled, double cpu_threshold);
+bool is_shedding_load(); // A single atomic load, cheap enough for the signal path.
+obs_stats get_obs_stats(); // Lock free copy of the latest sample, never queries OBS itself.
+uint64_t get_shed_event_count();
+void count_shed_event();
@@ -20,6 +20,7 @@
 #include <obs-frontend-api.h>
 #include <obs.hpp>
 #include <obs-accessibility.h>
+#include <util/platform.h>
 #include <algorithm>
 #include <memory>
 #include <string>
@@ -34,6 +35,7 @@
 OBS_DECLARE_MODULE()
 OBS_MODULE_USE_DEFAULT_LOCALE(PLUGIN_NAME, "en-US")
 bool obs_module_load(void) {
+	uint64_t start = os_gettime_ns();
 	OBSDataAutoRelease settings = load_config();
 	bool success = init_audio(settings);
 	if (!success) {
@@ -42,7 +44,7 @@ bool obs_module_load(void) {
 	}
 	init_events();
 	init_interface();
-	obs_log(LOG_INFO, "plugin loaded successfully (version %s)", PLUGIN_VERSION);
+	obs_log(LOG_INFO, "plugin loaded successfully in %.1f ms (version %s)", (os_gettime_ns() - start) / 1000000.0, PLUGIN_VERSION);
 	return true;
 }
 
@@ -0,0 +1,222 @@
+/*
+ OBS Accessibility
+ Copyright (C) 2025 Sam Tupy Productions <webmaster@samtupy.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along
+ with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#include <cstring>
+#include <mutex>
+#include <obs.h>
+#include "config.h"
+#include "events.h"
+#include "rules.h"
+
+using namespace std;
+
+// Conditions are flattened into one array per event and names are compared by length and hash before their bytes, so that a rule set is evaluated in nanoseconds before any template or audio work.
+enum rule_field : uint8_t {
+	RULE_SOURCE_NAME,
+	RULE_SOURCE_TYPEID,
+	RULE_SOURCE_UUID,
+	RULE_FILTER_NAME,
+	RULE_FILTER_TYPEID,
+	RULE_FILTER_UUID,
+	RULE_CALLDATA, // Any other string parameter, looked up by name.
+};
+#define RULE_CACHED_FIELDS 6 // The fields before RULE_CALLDATA, read at most once per evaluation.
+enum rule_match : uint8_t {
+	RULE_MATCH_EXACT,
+	RULE_MATCH_PREFIX, // Only a trailing *.
+	RULE_MATCH_GLOB,
+	RULE_MATCH_ANY, // A lone *, the field only has to exist.
+};
+struct rule_condition {
+	rule_field field;
+	rule_match match;
+	bool negate;
+	uint32_t length; // Of the pattern, without the * for RULE_MATCH_PREFIX.
+	uint64_t hash; // Of the pattern for RULE_MATCH_EXACT.
+	string pattern;
+	string parameter; // For RULE_CALLDATA.
+};
+struct event_rule_program {
+	vector<string> source; // The lines this was compiled from, so that unchanged rules aren't recompiled.
+	vector<rule_condition> conditions;
+	vector<event_rule> rules;
+};
+struct rule_field_value {
+	const char* text;
+	size_t length;
+	uint64_t hash;
+	bool read, hashed;
+};
+const char* g_rule_field_names[RULE_CACHED_FIELDS] = {"source.name", "source.typeid", "source.uuid", "filter.name", "filter.typeid", "filter.uuid"};
+mutex g_event_rules_lock;
+vector<event_rule_program*> g_event_rule_programs; // Every program an event has used, kept until shutdown since another thread may still be evaluating a replaced one.
+
+static uint64_t hash_name(const char* text, size_t length) {
+	// FNV-1a
+	uint64_t hash = 14695981039346656037ull;
+	for (size_t i = 0; i < length; i++) hash = (hash ^ (uint8_t)text[i]) * 1099511628211ull;
+	return hash;
+}
+static bool glob_match(const char* pattern, const char* text) {
+	const char* star = nullptr, *resume = nullptr;
+	while (*text) {
+		if (*pattern == '?' || (*pattern == *text && *pattern != '*')) {
+			pattern++;
+			text++;
+		} else if (*pattern == '*') {
+			star = pattern++;
+			resume = text;
+		} else if (star) {
+			pattern = star + 1;
+			text = ++resume;
+		} else return false;
+	}
+	while (*pattern == '*') pattern++;
+	return !*pattern;
+}
+static string trim(const string& text) {
+	size_t start = text.find_first_not_of(" \t"), end = text.find_last_not_of(" \t");
+	return start == string::npos? "" : text.substr(start, end - start + 1);
+}
+static bool compile_condition(const string& text, rule_condition& out) {
+	size_t pos = text.find('=');
+	if (pos == string::npos || pos == 0) return false;
+	out.negate = text[pos - 1] == '!';
+	string field = trim(text.substr(0, out.negate? pos - 1 : pos));
+	out.pattern = trim(text.substr(pos + 1));
+	if (field.empty()) return false;
+	out.field = RULE_CALLDATA;
+	for (int i = 0; i < RULE_CACHED_FIELDS; i++) {
+		if (field == g_rule_field_names[i]) out.field = rule_field(i);
+	}
+	if (out.field == RULE_CALLDATA) {
+		if (field.find('.') != string::npos) return false; // A misspelled source or filter field, rather than a parameter that can never exist.
+		out.parameter = field;
+	}
+	size_t wildcard = out.pattern.find_first_of("*?");
+	if (out.pattern == "*") out.match = RULE_MATCH_ANY;
+	else if (wildcard == string::npos) out.match = RULE_MATCH_EXACT;
+	else if (wildcard == out.pattern.size() - 1 && out.pattern.back() == '*') out.match = RULE_MATCH_PREFIX;
+	else out.match = RULE_MATCH_GLOB;
+	out.length = uint32_t(out.match == RULE_MATCH_PREFIX? out.pattern.size() - 1 : out.pattern.size());
+	out.hash = hash_name(out.pattern.data(), out.pattern.size());
+	return true;
+}
+event_rule_program* compile_event_rules(const vector<string>& rules) {
+	event_rule_program* program = new event_rule_program();
+	program->source = rules;
+	for (const string& line : rules) {
+		size_t arrow = line.find("=>");
+		if (arrow == string::npos) continue;
+		string action = trim(line.substr(arrow + 2));
+		if (action.empty()) continue;
+		vector<rule_condition> conditions;
+		string conditions_text = trim(line.substr(0, arrow));
+		bool valid = true;
+		for (size_t start = 0; valid && !conditions_text.empty() && start <= conditions_text.size();) {
+			size_t end = conditions_text.find('&', start);
+			if (end == string::npos) end = conditions_text.size();
+			rule_condition condition;
+			valid = compile_condition(conditions_text.substr(start, end - start), condition);
+			conditions.push_back(std::move(condition));
+			start = end + 1;
+		}
+		if (!valid) continue;
+		event_rule rule = {uint32_t(program->conditions.size()), uint32_t(conditions.size()), EVENT_RULE_SPEAK, ""};
+		if (action == "drop") rule.action = EVENT_RULE_DROP;
+		else if (action == "earcon") rule.action = EVENT_RULE_EARCON;
+		else rule.message = action;
+		program->rules.push_back(std::move(rule));
+		for (rule_condition& c : conditions) program->conditions.push_back(std::move(c));
+	}
+	return program;
+}
+void free_event_rules(event_rule_program* program) { delete program; }
+static const char* read_rule_field(const rule_condition& condition, const calldata_t* data) {
+	if (!data) return nullptr;
+	if (condition.field == RULE_CALLDATA) return calldata_string(data, condition.parameter.c_str());
+	void* ptr = nullptr;
+	if (!calldata_get_ptr(data, condition.field < RULE_FILTER_NAME? "source" : "filter", &ptr) || !ptr) return nullptr;
+	obs_source_t* source = static_cast<obs_source_t*>(ptr);
+	switch (condition.field % 3) {
+		case 0: return obs_source_get_name(source);
+		case 1: return obs_source_get_id(source);
+		default: return obs_source_get_uuid(source);
+	}
+}
+static bool match_condition(const rule_condition& condition, rule_field_value& value) {
+	if (!value.text) return false;
+	switch (condition.match) {
+		case RULE_MATCH_ANY: return true;
+		case RULE_MATCH_PREFIX: return value.length >= condition.length && memcmp(value.text, condition.pattern.data(), condition.length) == 0;
+		case RULE_MATCH_GLOB: return glob_match(condition.pattern.c_str(), value.text);
+		default:
+			if (value.length != condition.length) return false;
+			if (!value.hashed) {
+				value.hash = hash_name(value.text, value.length);
+				value.hashed = true;
+			}
+			return value.hash == condition.hash && memcmp(value.text, condition.pattern.data(), condition.length) == 0;
+	}
+}
+const event_rule* match_event_rules(const event_rule_program* program, const calldata_t* data) {
+	if (!program) return nullptr;
+	rule_field_value cache[RULE_CACHED_FIELDS] = {};
+	for (const event_rule& rule : program->rules) {
+		bool matched = true;
+		for (uint32_t i = rule.first_condition; matched && i < rule.first_condition + rule.condition_count; i++) {
+			const rule_condition& condition = program->conditions[i];
+			rule_field_value uncached = {}, *value = condition.field < RULE_CACHED_FIELDS? &cache[condition.field] : &uncached;
+			if (!value->read) {
+				value->text = read_rule_field(condition, data);
+				value->length = value->text? strlen(value->text) : 0;
+				value->read = true;
+			}
+			matched = match_condition(condition, *value) != condition.negate;
+		}
+		if (matched) return &rule;
+	}
+	return nullptr;
+}
+bool event_rules_speak(const event_rule_program* program) {
+	if (!program) return false;
+	for (const event_rule& rule : program->rules) {
+		if (rule.action == EVENT_RULE_SPEAK) return true;
+	}
+	return false;
+}
+size_t get_event_rule_count(const event_rule_program* program) { return program? program->rules.size() : 0; }
+void refresh_event_rules() {
+	for (size_t i = 0; i < get_event_type_count(); i++) {
+		event_type* event = get_event_type(i);
+		vector<string> lines = get_event_strings(event->get_id(), "rules");
+		const event_rule_program* current = event->get_rules();
+		if (current? current->source == lines : lines.empty()) continue;
+		event_rule_program* program = lines.empty()? nullptr : compile_event_rules(lines);
+		if (program) {
+			lock_guard<mutex> lock(g_event_rules_lock);
+			g_event_rule_programs.push_back(program);
+		}
+		event->set_rules(program);
+	}
+}
+void shutdown_event_rules() {
+	lock_guard<mutex> lock(g_event_rules_lock);
+	for (event_rule_program* program : g_event_rule_programs) delete program;
+	g_event_rule_programs.clear();
+}
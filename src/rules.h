@@ -0,0 +1,48 @@
+/*
+ OBS Accessibility
+ Copyright (C) 2025 Sam Tupy Productions <webmaster@samtupy.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along
+ with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <obs.h>
+
+// Per event rules decide from a signal's parameters whether it is announced. Each rule is one line, conditions joined by & followed by => and an action:
+//   source.name=Helper* => drop
+//   source.typeid=scene & source.name!=Main => earcon
+//   filter.name=Noise* => {filter.name} added to {source.name}
+// Conditions read the name, typeid or uuid of the source or filter parameter, or any other string parameter by its name, and patterns may use * and ?. The action is drop, earcon for the earcon without speech, or a message to speak in place of the event's own. The first rule that matches wins, and an event matching none is announced as usual.
+enum event_rule_action {
+	EVENT_RULE_DROP,
+	EVENT_RULE_EARCON,
+	EVENT_RULE_SPEAK,
+};
+struct event_rule {
+	uint32_t first_condition, condition_count;
+	event_rule_action action;
+	std::string message;
+};
+struct event_rule_program; // Compiled rules for one event, see compile_event_rules().
+
+event_rule_program* compile_event_rules(const std::vector<std::string>& rules); // Lines that don't parse are skipped. Release with free_event_rules().
+void free_event_rules(event_rule_program* program);
+const event_rule* match_event_rules(const event_rule_program* program, const calldata_t* data); // Safe from any thread and never allocates, returns null if no rule matched or program is null.
+bool event_rules_speak(const event_rule_program* program); // Whether any rule speaks a message of its own.
+size_t get_event_rule_count(const event_rule_program* program);
+void refresh_event_rules(); // Recompiles the rules of every event whose configuration changed, called by refresh_event_cache().
+void shutdown_event_rules(); // Frees every program, call once the event types are unregistered.
@@ -0,0 +1,251 @@
+/*
+ OBS Accessibility
+ Copyright (C) 2025 Sam Tupy Productions <webmaster@samtupy.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along
+ with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <obs.h>
+#include <obs-frontend-api.h>
+#include "scenes.h"
+
+using namespace std;
+
+// Mirrored items hold a reference on their source, released only once the lock is dropped since that can raise source_destroy.
+struct mirrored_item {
+	int64_t id;
+	obs_source_t* source;
+	bool visible;
+};
+struct mirrored_source {
+	string name;
+	float volume;
+	bool has_audio;
+	size_t items; // Number of mirrored items showing this source, it is forgotten at zero.
+};
+mutex g_mirror_lock;
+atomic<uint64_t> g_mirror_generation = 0;
+bool g_mirror_active = false;
+unordered_map<obs_source_t*, vector<mirrored_item>> g_mirror_scenes; // Keyed by scene source, items bottom to top.
+unordered_map<obs_source_t*, mirrored_source> g_mirror_sources;
+const char* g_mirror_scene_signals[] = {"item_add", "item_remove", "item_visible", "reorder", "refresh", nullptr};
+
+static void on_mirror_source_mute(void*, calldata_t*) {
+	// Mute state is read straight from the source by get_scene_items(), but descriptions rendered ahead of time still need to know it changed.
+	g_mirror_generation++;
+}
+static void mirror_add_source(obs_source_t* source) {
+	// Call with g_mirror_lock held.
+	auto it = g_mirror_sources.find(source);
+	if (it != g_mirror_sources.end()) {
+		it->second.items++;
+		return;
+	}
+	const char* name = obs_source_get_name(source);
+	g_mirror_sources[source] = {name? name : "", obs_source_get_volume(source), (obs_source_get_output_flags(source) & OBS_SOURCE_AUDIO) != 0, 1};
+	// OBS has no global mute signal, so each mirrored source is watched for as long as it is mirrored.
+	signal_handler_connect(obs_source_get_signal_handler(source), "mute", on_mirror_source_mute, nullptr);
+}
+static void mirror_remove_source(obs_source_t* source) {
+	// Call with g_mirror_lock held.
+	auto it = g_mirror_sources.find(source);
+	if (it == g_mirror_sources.end() || --it->second.items) return;
+	signal_handler_disconnect(obs_source_get_signal_handler(source), "mute", on_mirror_source_mute, nullptr);
+	g_mirror_sources.erase(it);
+}
+static void release_sources(const vector<obs_source_t*>& sources) {
+	for (obs_source_t* source : sources) obs_source_release(source);
+}
+static void mirror_scene_items(obs_source_t* scene_source) {
+	// Takes a fresh copy of the scene's items, used when a scene is first mirrored and whenever OBS reorders or refreshes it.
+	vector<mirrored_item> items;
+	obs_scene_enum_items(obs_scene_from_source(scene_source), [](obs_scene_t*, obs_sceneitem_t* item, void* param) {
+		obs_source_t* source = obs_source_get_ref(obs_sceneitem_get_source(item));
+		if (source) static_cast<vector<mirrored_item>*>(param)->push_back({obs_sceneitem_get_id(item), source, obs_sceneitem_visible(item)});
+		return true;
+	}, &items);
+	vector<obs_source_t*> released;
+	{
+		lock_guard<mutex> lock(g_mirror_lock);
+		auto it = g_mirror_scenes.find(scene_source);
+		if (it == g_mirror_scenes.end()) {
+			for (const mirrored_item& i : items) released.push_back(i.source);
+		} else {
+			for (const mirrored_item& i : items) mirror_add_source(i.source);
+			for (const mirrored_item& i : it->second) {
+				mirror_remove_source(i.source);
+				released.push_back(i.source);
+			}
+			it->second.swap(items);
+			g_mirror_generation++;
+		}
+	}
+	release_sources(released);
+}
+static void on_mirror_item_add(void*, calldata_t* data) {
+	obs_sceneitem_t* item = static_cast<obs_sceneitem_t*>(calldata_ptr(data, "item"));
+	obs_source_t* scene_source = obs_scene_get_source(static_cast<obs_scene_t*>(calldata_ptr(data, "scene")));
+	obs_source_t* source = obs_source_get_ref(obs_sceneitem_get_source(item));
+	if (!source) return;
+	int64_t id = obs_sceneitem_get_id(item);
+	bool added = false;
+	{
+		lock_guard<mutex> lock(g_mirror_lock);
+		auto it = g_mirror_scenes.find(scene_source);
+		// The same item can be seen twice if it was added while its scene was first being mirrored.
+		if (it != g_mirror_scenes.end() && none_of(it->second.begin(), it->second.end(), [&](const mirrored_item& i) { return i.id == id; })) {
+			it->second.push_back({id, source, obs_sceneitem_visible(item)});
+			mirror_add_source(source);
+			added = true;
+			g_mirror_generation++;
+		}
+	}
+	if (!added) obs_source_release(source);
+}
+static void on_mirror_item_remove(void*, calldata_t* data) {
+	obs_sceneitem_t* item = static_cast<obs_sceneitem_t*>(calldata_ptr(data, "item"));
+	obs_source_t* scene_source = obs_scene_get_source(static_cast<obs_scene_t*>(calldata_ptr(data, "scene")));
+	int64_t id = obs_sceneitem_get_id(item);
+	obs_source_t* released = nullptr;
+	{
+		lock_guard<mutex> lock(g_mirror_lock);
+		auto it = g_mirror_scenes.find(scene_source);
+		if (it == g_mirror_scenes.end()) return;
+		auto i = find_if(it->second.begin(), it->second.end(), [&](const mirrored_item& i) { return i.id == id; });
+		if (i == it->second.end()) return;
+		released = i->source;
+		mirror_remove_source(released);
+		it->second.erase(i);
+		g_mirror_generation++;
+	}
+	obs_source_release(released);
+}
+static void on_mirror_item_visible(void*, calldata_t* data) {
+	obs_sceneitem_t* item = static_cast<obs_sceneitem_t*>(calldata_ptr(data, "item"));
+	obs_source_t* scene_source = obs_scene_get_source(static_cast<obs_scene_t*>(calldata_ptr(data, "scene")));
+	int64_t id = obs_sceneitem_get_id(item);
+	bool visible = calldata_bool(data, "visible");
+	lock_guard<mutex> lock(g_mirror_lock);
+	auto it = g_mirror_scenes.find(scene_source);
+	if (it == g_mirror_scenes.end()) return;
+	for (mirrored_item& i : it->second) {
+		if (i.id == id) i.visible = visible;
+	}
+	g_mirror_generation++;
+}
+static void on_mirror_reorder(void* param, calldata_t* data) {
+	obs_source_t* scene_source = obs_scene_get_source(static_cast<obs_scene_t*>(calldata_ptr(data, "scene")));
+	if (scene_source) mirror_scene_items(scene_source);
+}
+signal_callback_t g_mirror_scene_callbacks[] = {on_mirror_item_add, on_mirror_item_remove, on_mirror_item_visible, on_mirror_reorder, on_mirror_reorder};
+static void track_scene(obs_source_t* scene_source) {
+	{
+		lock_guard<mutex> lock(g_mirror_lock);
+		if (!g_mirror_active || !g_mirror_scenes.emplace(scene_source, vector<mirrored_item>()).second) return;
+	}
+	// Connected before the items are copied, so that nothing added in between is missed.
+	signal_handler_t* handler = obs_source_get_signal_handler(scene_source);
+	for (int i = 0; g_mirror_scene_signals[i]; i++) signal_handler_connect(handler, g_mirror_scene_signals[i], g_mirror_scene_callbacks[i], nullptr);
+	mirror_scene_items(scene_source);
+}
+static void untrack_scene(obs_source_t* scene_source, vector<obs_source_t*>& released) {
+	// Call with g_mirror_lock held, then release what was collected once it is dropped.
+	auto it = g_mirror_scenes.find(scene_source);
+	if (it == g_mirror_scenes.end()) return;
+	signal_handler_t* handler = obs_source_get_signal_handler(scene_source);
+	for (int i = 0; g_mirror_scene_signals[i]; i++) signal_handler_disconnect(handler, g_mirror_scene_signals[i], g_mirror_scene_callbacks[i], nullptr);
+	for (const mirrored_item& i : it->second) {
+		mirror_remove_source(i.source);
+		released.push_back(i.source);
+	}
+	g_mirror_scenes.erase(it);
+	g_mirror_generation++;
+}
+static void on_mirror_source_create(void*, calldata_t* data) {
+	obs_source_t* source = static_cast<obs_source_t*>(calldata_ptr(data, "source"));
+	if (obs_scene_from_source(source)) track_scene(source);
+}
+static void on_mirror_source_destroy(void*, calldata_t* data) {
+	obs_source_t* source = static_cast<obs_source_t*>(calldata_ptr(data, "source"));
+	vector<obs_source_t*> released;
+	{
+		lock_guard<mutex> lock(g_mirror_lock);
+		untrack_scene(source, released);
+	}
+	release_sources(released);
+}
+static void on_mirror_source_rename(void*, calldata_t* data) {
+	obs_source_t* source = static_cast<obs_source_t*>(calldata_ptr(data, "source"));
+	const char* name = calldata_string(data, "new_name");
+	g_mirror_generation++; // Scene names count too, though only their items' sources are mirrored.
+	lock_guard<mutex> lock(g_mirror_lock);
+	auto it = g_mirror_sources.find(source);
+	if (it != g_mirror_sources.end() && name) it->second.name = name;
+}
+static void on_mirror_source_volume(void*, calldata_t* data) {
+	obs_source_t* source = static_cast<obs_source_t*>(calldata_ptr(data, "source"));
+	lock_guard<mutex> lock(g_mirror_lock);
+	auto it = g_mirror_sources.find(source);
+	if (it == g_mirror_sources.end()) return;
+	it->second.volume = float(calldata_float(data, "volume"));
+	g_mirror_generation++;
+}
+void init_scene_mirror() {
+	{
+		lock_guard<mutex> lock(g_mirror_lock);
+		if (g_mirror_active) return;
+		g_mirror_active = true;
+	}
+	signal_handler_t* core_handler = obs_get_signal_handler();
+	signal_handler_connect(core_handler, "source_create", on_mirror_source_create, nullptr);
+	signal_handler_connect(core_handler, "source_destroy", on_mirror_source_destroy, nullptr);
+	signal_handler_connect(core_handler, "source_rename", on_mirror_source_rename, nullptr);
+	signal_handler_connect(core_handler, "source_volume", on_mirror_source_volume, nullptr);
+	obs_frontend_source_list scenes = {};
+	obs_frontend_get_scenes(&scenes);
+	for (size_t i = 0; i < scenes.sources.num; i++) track_scene(scenes.sources.array[i]);
+	obs_frontend_source_list_free(&scenes);
+}
+void clear_scene_mirror() {
+	signal_handler_t* core_handler = obs_get_signal_handler();
+	signal_handler_disconnect(core_handler, "source_create", on_mirror_source_create, nullptr);
+	signal_handler_disconnect(core_handler, "source_destroy", on_mirror_source_destroy, nullptr);
+	signal_handler_disconnect(core_handler, "source_rename", on_mirror_source_rename, nullptr);
+	signal_handler_disconnect(core_handler, "source_volume", on_mirror_source_volume, nullptr);
+	vector<obs_source_t*> released;
+	{
+		lock_guard<mutex> lock(g_mirror_lock);
+		g_mirror_active = false;
+		while (!g_mirror_scenes.empty()) untrack_scene(g_mirror_scenes.begin()->first, released);
+		g_mirror_sources.clear();
+	}
+	release_sources(released);
+}
+bool get_scene_items(obs_source_t* scene, vector<scene_item_state>& out) {
+	out.clear();
+	lock_guard<mutex> lock(g_mirror_lock);
+	auto it = g_mirror_scenes.find(scene);
+	if (it == g_mirror_scenes.end()) return false;
+	out.reserve(it->second.size());
+	for (auto i = it->second.rbegin(); i != it->second.rend(); ++i) {
+		const mirrored_source& source = g_mirror_sources[i->source];
+		out.push_back({i->id, source.name, i->visible, obs_source_muted(i->source), source.has_audio, source.volume});
+	}
+	return true;
+}
+uint64_t get_scene_mirror_generation() { return g_mirror_generation.load(); }
@@ -0,0 +1,38 @@
+/*
+ OBS Accessibility
+ Copyright (C) 2025 Sam Tupy Productions <webmaster@samtupy.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along
+ with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <obs.h>
+
+struct scene_item_state {
+	int64_t id;
+	std::string name;
+	bool visible;
+	bool muted;
+	bool has_audio; // Volume and mute only mean something for sources with audio.
+	float volume;
+};
+
+// A copy of every scene's items kept current from scene and source signals, so that announcing a scene's contents never walks or locks the scene itself.
+void init_scene_mirror(); // Builds the mirror and starts following changes, call once OBS has finished loading and after each scene collection change.
+void clear_scene_mirror(); // Stops following changes and drops the mirror, call when the scene collection is about to change and on exit.
+bool get_scene_items(obs_source_t* scene, std::vector<scene_item_state>& out); // Top to bottom as in the sources dock. Returns false if the scene isn't mirrored.
+uint64_t get_scene_mirror_generation(); // Advances whenever the mirror changes or any source is renamed, so that text rendered from it can tell when it went stale.
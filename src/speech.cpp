@@ -22,35 +22,202 @@
 	#include <filesystem>
 	#include <QTCore/QString>
 #endif
+#include <algorithm>
+#include <deque>
+#include <mutex>
 #include <prism.h>
+#include <util/platform.h>
 #include "speech.h"
 
 using namespace std;
 
+// Every backend that initialized, with running latency and failure numbers. The loopback backend is always first and has no prism backend.
+struct speech_backend {
+	string name;
+	PrismBackend* backend;
+	uint64_t init_ns; // How long prism_backend_initialize took, kept apart since it says little about how quickly the backend speaks.
+	uint64_t calls; // Speak calls, a backend that has never spoken is unmeasured.
+	uint64_t failures;
+	uint64_t consecutive_failures;
+	double average_ns;
+	uint64_t last_call; // os_gettime_ns() of the latest speak call, 0 if it never spoke.
+};
 PrismContext* g_speech_ctx = nullptr;
-PrismBackend* g_speech_backend = nullptr;
-bool init_speech() {
-	if (g_speech_ctx && g_speech_backend) return true;
-	if (!g_speech_ctx) {
+bool g_speech_probed = false;
+vector<speech_backend> g_speech_backends;
+size_t g_speech_current = 0; // Index into g_speech_backends, 0 until a backend has been selected.
+size_t g_speech_trial = 0; // Another backend that speaks the next utterance so that its latency is measured too, 0 for none.
+string g_speech_preference; // Backend name chosen in settings, empty for automatic.
+string g_speech_best; // The backend prism ranks best, used to break ties between similarly fast backends.
+uint64_t g_speech_since_selection = 0;
+uint64_t g_speech_busy_until = 0; // os_gettime_ns() time the last utterance is expected to finish.
+deque<loopback_utterance> g_loopback_utterances;
+mutex g_speech_lock; // The startup task initializes speech while the dispatch thread may already want to speak.
+bool is_speech_failure(PrismError error) {
+	// Idle backends are allowed to report that stopping or a feature isn't applicable.
+	return error != PRISM_OK && error != PRISM_ERROR_NOT_SPEAKING && error != PRISM_ERROR_NOT_IMPLEMENTED && error != PRISM_ERROR_ALREADY_INITIALIZED;
+}
+void record_speech_call(speech_backend& b, bool success, uint64_t elapsed_ns) {
+	b.average_ns = b.calls? b.average_ns * 0.875 + elapsed_ns * 0.125 : elapsed_ns;
+	b.calls++;
+	b.last_call = os_gettime_ns();
+	if (success) b.consecutive_failures = 0;
+	else {
+		b.failures++;
+		b.consecutive_failures++;
+	}
+}
+bool is_speech_backend_reliable(const speech_backend& b) {
+	if (b.consecutive_failures >= 3) return false;
+	return b.calls < 8 || b.failures * 5 < b.calls;
+}
+void select_speech_backend() {
+	g_speech_since_selection = 0;
+	g_speech_current = 0;
+	g_speech_trial = 0;
+	if (!g_speech_preference.empty()) {
+		for (size_t i = 0; i < g_speech_backends.size(); i++) {
+			if (g_speech_backends[i].name != g_speech_preference) continue;
+			g_speech_current = i;
+			return;
+		}
+	}
+	// By default prism's own ranking is kept, since it puts the user's screen reader ahead of any faster system voice. Latency only decides once the user opts in, or when that backend keeps failing.
+	if (g_speech_preference != SPEECH_FASTEST_CHOICE) {
+		for (size_t i = 1; i < g_speech_backends.size(); i++) {
+			const speech_backend& b = g_speech_backends[i];
+			if (b.name != g_speech_best || !is_speech_backend_reliable(b)) continue;
+			g_speech_current = i;
+			return;
+		}
+	}
+	// The loopback backend never takes part in automatic selection, it would always win while saying nothing. Only backends that have spoken are compared, by how long their speak calls take.
+	double fastest = 0;
+	for (size_t i = 1; i < g_speech_backends.size(); i++) {
+		const speech_backend& b = g_speech_backends[i];
+		if (!b.calls || !is_speech_backend_reliable(b)) continue;
+		if (!g_speech_current || b.average_ns < fastest) {
+			g_speech_current = i;
+			fastest = b.average_ns;
+		}
+	}
+	for (size_t i = 1; i < g_speech_backends.size(); i++) {
+		const speech_backend& b = g_speech_backends[i];
+		if (b.name != g_speech_best || !is_speech_backend_reliable(b)) continue;
+		// Prism's choice also stands in while nothing has been measured yet.
+		if (!g_speech_current || (b.calls && b.average_ns - fastest <= SPEECH_LATENCY_TOLERANCE_MS * 1000000)) g_speech_current = i;
+	}
+	for (size_t i = 1; i < g_speech_backends.size() && !g_speech_current; i++) {
+		if (is_speech_backend_reliable(g_speech_backends[i])) g_speech_current = i;
+	}
+	if (g_speech_preference != SPEECH_FASTEST_CHOICE) return;
+	// The backend measured longest ago, unmeasured ones first, speaks the next utterance so that every backend keeps being compared on real speech.
+	for (size_t i = 1; i < g_speech_backends.size(); i++) {
+		const speech_backend& b = g_speech_backends[i];
+		if (i == g_speech_current || !is_speech_backend_reliable(b)) continue;
+		if (!g_speech_trial || b.last_call < g_speech_backends[g_speech_trial].last_call) g_speech_trial = i;
+	}
+}
+void probe_speech_backends() {
+	g_speech_backends.push_back({SPEECH_LOOPBACK_NAME, nullptr, 0, 0, 0, 0, 0, 0});
+	if (!g_speech_ctx) return;
+	PrismBackend* best = prism_registry_acquire_best(g_speech_ctx);
+	if (best) {
+		const char* name = prism_backend_name(best);
+		g_speech_best = name? name : "";
+		prism_backend_free(best);
+	}
+	for (size_t i = 0; i < prism_registry_count(g_speech_ctx); i++) {
+		PrismBackendId id = prism_registry_id_at(g_speech_ctx, i);
+		PrismBackend* backend = prism_registry_create(g_speech_ctx, id);
+		if (!backend) continue;
+		uint64_t start = os_gettime_ns();
+		if (is_speech_failure(prism_backend_initialize(backend))) {
+			prism_backend_free(backend);
+			continue;
+		}
+		const char* name = prism_backend_name(backend);
+		if (!name) name = prism_registry_name(g_speech_ctx, id);
+		// Initialization is the only thing timed up front, calls such as stop would cut off whatever the user's screen reader was saying. Latency is then measured from real utterances as they are spoken.
+		g_speech_backends.push_back({name? name : "", backend, os_gettime_ns() - start, 0, 0, 0, 0, 0});
+	}
+}
+bool init_speech_locked() {
+	if (!g_speech_probed) {
 		#ifdef _WIN32
 			obs_module_t* mod = obs_current_module();
 			filesystem::path module_bin(obs_get_module_binary_path(mod));
 			SetDllDirectoryW(module_bin.parent_path().wstring().c_str()); // Now any additional screen reader dlls can load from the specified plugin bin directory.
 		#endif
-		g_speech_ctx = prism_init(nullptr);
-		if (!g_speech_ctx) return false;
+		g_speech_ctx = prism_init(nullptr); // Without prism only the loopback backend is available.
+		probe_speech_backends();
+		select_speech_backend();
+		g_speech_probed = true;
 	}
-	g_speech_backend = prism_registry_acquire_best(g_speech_ctx);
-	return g_speech_backend != nullptr;
+	return g_speech_current || g_speech_preference == SPEECH_LOOPBACK_NAME;
+}
+bool init_speech() {
+	lock_guard<mutex> lock(g_speech_lock);
+	return init_speech_locked();
 }
 void shutdown_speech() {
-	if (g_speech_backend) prism_backend_free(g_speech_backend);
-	g_speech_backend = nullptr;
-	prism_shutdown(g_speech_ctx);
+	lock_guard<mutex> lock(g_speech_lock);
+	for (speech_backend& b : g_speech_backends) {
+		if (b.backend) prism_backend_free(b.backend);
+	}
+	g_speech_backends.clear();
+	g_speech_current = 0;
+	g_speech_trial = 0;
+	g_loopback_utterances.clear();
+	if (g_speech_ctx) prism_shutdown(g_speech_ctx);
 	g_speech_ctx = nullptr;
+	g_speech_probed = false;
+}
+bool speak_with(speech_backend& b, const string& text, bool interrupt) {
+	uint64_t start = os_gettime_ns();
+	bool success = true;
+	if (b.backend) success = prism_backend_speak(b.backend, text.c_str(), interrupt) == PRISM_OK;
+	else {
+		if (g_loopback_utterances.size() >= SPEECH_LOOPBACK_HISTORY) g_loopback_utterances.pop_front();
+		g_loopback_utterances.push_back({text, interrupt, start});
+	}
+	record_speech_call(b, success, os_gettime_ns() - start);
+	if (success) g_speech_busy_until = (interrupt? start : max(start, g_speech_busy_until)) + text.size() * SPEECH_MS_PER_CHARACTER * 1000000;
+	return success;
 }
 bool speak(const string& text, bool interrupt) {
-	if (!init_speech()) return false;
-	return prism_backend_speak(g_speech_backend, text.c_str(), interrupt) == PRISM_OK;
+	lock_guard<mutex> lock(g_speech_lock);
+	if (!init_speech_locked()) return false;
+	size_t used = g_speech_trial? g_speech_trial : g_speech_current;
+	g_speech_trial = 0;
+	bool success = speak_with(g_speech_backends[used], text, interrupt);
+	if (success && used == g_speech_current && ++g_speech_since_selection < SPEECH_RESELECT_INTERVAL) return true;
+	select_speech_backend();
+	// A failed utterance is retried once if that failure made another backend the better choice.
+	if (!success && g_speech_current != used && (g_speech_current || g_speech_preference == SPEECH_LOOPBACK_NAME)) success = speak_with(g_speech_backends[g_speech_current], text, interrupt);
+	return success;
+}
+bool is_speech_busy() {
+	lock_guard<mutex> lock(g_speech_lock);
+	return os_gettime_ns() < g_speech_busy_until;
+}
+void set_speech_backend(const string& name) {
+	lock_guard<mutex> lock(g_speech_lock);
+	if (g_speech_preference == name) return;
+	g_speech_preference = name;
+	if (g_speech_probed) select_speech_backend();
+}
+vector<speech_backend_stats> get_speech_backend_stats() {
+	lock_guard<mutex> lock(g_speech_lock);
+	vector<speech_backend_stats> stats;
+	for (size_t i = 0; i < g_speech_backends.size(); i++) {
+		const speech_backend& b = g_speech_backends[i];
+		bool selected = i == g_speech_current && (i || g_speech_preference == SPEECH_LOOPBACK_NAME);
+		stats.push_back({b.name, b.calls, b.failures, b.average_ns / 1000000.0, b.init_ns / 1000000.0, selected});
+	}
+	return stats;
+}
+vector<loopback_utterance> get_loopback_utterances() {
+	lock_guard<mutex> lock(g_speech_lock);
+	return vector<loopback_utterance>(g_loopback_utterances.begin(), g_loopback_utterances.end());
 }
-
@@ -17,8 +17,35 @@
 */
 
 #pragma once
+#include <cstdint>
 #include <string>
+#include <vector>
 
-bool init_speech();
+#define SPEECH_LOOPBACK_NAME "Loopback" // Built in backend that records what it is asked to say instead of speaking, for testing without a screen reader.
+#define SPEECH_LOOPBACK_HISTORY 64 // Utterances the loopback backend remembers.
+#define SPEECH_FASTEST_CHOICE "*fastest" // Backend preference that opts in to whichever reliable backend answers fastest, instead of the one prism ranks best.
+#define SPEECH_LATENCY_TOLERANCE_MS 2.0 // When choosing by latency, backends this close to the fastest are considered as fast, and prism's own ranking decides between them.
+#define SPEECH_RESELECT_INTERVAL 32 // Utterances between automatic backend reevaluations. When choosing by latency, each reevaluation also has one other backend speak an utterance to measure it.
+#define SPEECH_MS_PER_CHARACTER 25 // Rough time a screen reader takes per character at the brisk rates its users favor, used to guess when speech goes quiet.
+
+struct speech_backend_stats {
+	std::string name;
+	uint64_t calls;
+	uint64_t failures;
+	double average_ms; // Of speak calls, exponentially weighted so that recent calls count the most. 0 until the backend has spoken.
+	double init_ms; // How long the backend took to initialize.
+	bool selected;
+};
+struct loopback_utterance {
+	std::string text;
+	bool interrupt;
+	uint64_t timestamp; // os_gettime_ns() when it was spoken.
+};
+
+bool init_speech(); // Probes every prism backend, timing their initialization, then selects one.
 void shutdown_speech();
 bool speak(const std::string& text, bool interrupt = true);
+bool is_speech_busy(); // Guessed from the length of what was said recently, since screen readers can't be asked whether they are still talking.
+void set_speech_backend(const std::string& name); // Empty uses the backend prism ranks best while it stays reliable, SPEECH_FASTEST_CHOICE the fastest reliable backend, otherwise the named backend is used whenever it is available.
+std::vector<speech_backend_stats> get_speech_backend_stats();
+std::vector<loopback_utterance> get_loopback_utterances(); // Oldest first.
@@ -0,0 +1,359 @@
+/*
+ OBS Accessibility
+ Copyright (C) 2025 Sam Tupy Productions <webmaster@samtupy.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along
+ with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <fmt/format.h>
+#include <obs-module.h>
+#include <util/threading.h>
+#ifndef _WIN32
+	#include <fcntl.h>
+	#include <poll.h>
+	#include <sys/socket.h>
+	#include <sys/stat.h>
+	#include <sys/un.h>
+	#include <unistd.h>
+#endif
+#include "obs-accessibility.h"
+#include "stream.h"
+
+using namespace std;
+using namespace fmt;
+
+#define STREAM_RECORD_EVENT 1
+#define STREAM_RECORD_DROPPED 2
+
+string get_event_stream_path() {
+#ifdef _WIN32
+	return "";
+#else
+	const char* runtime_dir = getenv("XDG_RUNTIME_DIR");
+	if (runtime_dir && *runtime_dir) return format("{}/obs-accessibility.sock", runtime_dir);
+	return format("/tmp/obs-accessibility-{}.sock", getuid());
+#endif
+}
+
+static void append_json_string(string& out, const char* key, const string& value) {
+	out += format("\"{}\":\"", key);
+	for (char c : value) {
+		if (c == '"' || c == '\\') {
+			out += '\\';
+			out += c;
+		} else if (c == '\n') out += "\\n";
+		else if (c == '\r') out += "\\r";
+		else if (c == '\t') out += "\\t";
+		else if ((unsigned char)c < 0x20) out += format("\\u{:04x}", c);
+		else out += c;
+	}
+	out += "\",";
+}
+static void append_integer(string& out, uint64_t value, int bytes) {
+	for (int i = 0; i < bytes; i++) out += char((value >> (i * 8)) & 0xff); // Always little endian.
+}
+static void append_binary_string(string& out, const string& value, int length_bytes) {
+	size_t length = min(value.size(), size_t(length_bytes == 2? 0xffff : 0xffffffff));
+	append_integer(out, length, length_bytes);
+	out.append(value, 0, length);
+}
+static void finish_binary_record(string& out) {
+	// The first four bytes were reserved for the length of everything after them.
+	uint32_t length = uint32_t(out.size() - 4);
+	for (int i = 0; i < 4; i++) out[i] = char((length >> (i * 8)) & 0xff);
+}
+static string encode_dropped(uint64_t count, bool binary) {
+	if (!binary) return format("{{\"type\":\"dropped\",\"count\":{}}}\n", count);
+	string out(4, '\0');
+	out += char(STREAM_RECORD_DROPPED);
+	append_integer(out, count, 8);
+	finish_binary_record(out);
+	return out;
+}
+
+#ifndef _WIN32
+struct stream_client {
+	int fd;
+	bool binary = false; // Guarded by g_stream_lock along with pending and unreported.
+	string pending; // Records queued by publish_event(), at most EVENT_STREAM_CLIENT_BUFFER bytes.
+	uint64_t unreported = 0; // Records dropped since the client was last told about it.
+	// Owned by the stream thread, which swaps pending out into here so that it never writes to a socket with the lock held.
+	string outgoing;
+	size_t sent = 0;
+	string input;
+};
+mutex g_stream_lock;
+vector<unique_ptr<stream_client>> g_stream_clients;
+atomic<uint64_t> g_stream_client_count = 0, g_stream_published = 0, g_stream_dropped = 0;
+mutex g_stream_state_lock; // Serializes starting and stopping the stream.
+pthread_t g_stream_thread;
+atomic<bool> g_stream_running = false;
+int g_stream_listener = -1;
+int g_stream_wake[2] = {-1, -1}; // Self pipe that publish_event() writes to when a client goes from idle to having records waiting.
+string g_stream_path;
+
+static void set_nonblocking(int fd) {
+	fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+	fcntl(fd, F_SETFD, FD_CLOEXEC);
+}
+static void wake_stream() {
+	char c = 0;
+	if (write(g_stream_wake[1], &c, 1) < 0) {} // A full pipe means a wakeup is already pending.
+}
+static bool accept_client() {
+	int fd = accept(g_stream_listener, nullptr, nullptr);
+	if (fd < 0) return false;
+	if (g_stream_client_count >= EVENT_STREAM_MAX_CLIENTS) {
+		close(fd);
+		return true;
+	}
+	set_nonblocking(fd);
+#ifdef SO_NOSIGPIPE
+	int one = 1;
+	setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+	unique_ptr<stream_client> client = make_unique<stream_client>();
+	client->fd = fd;
+	lock_guard<mutex> lock(g_stream_lock);
+	g_stream_clients.push_back(std::move(client));
+	g_stream_client_count = g_stream_clients.size();
+	return true;
+}
+static void remove_client(stream_client* client) {
+	close(client->fd);
+	lock_guard<mutex> lock(g_stream_lock);
+	for (auto it = g_stream_clients.begin(); it != g_stream_clients.end(); it++) {
+		if (it->get() != client) continue;
+		g_stream_clients.erase(it);
+		break;
+	}
+	g_stream_client_count = g_stream_clients.size();
+}
+static bool read_client(stream_client* client) {
+	// Clients only ever send a line choosing the record format.
+	char buffer[256];
+	ssize_t received = recv(client->fd, buffer, sizeof(buffer), 0);
+	if (received == 0) return false;
+	if (received < 0) return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+	client->input.append(buffer, received);
+	size_t end;
+	while ((end = client->input.find('\n')) != string::npos) {
+		string line = client->input.substr(0, end);
+		client->input.erase(0, end + 1);
+		if (!line.empty() && line.back() == '\r') line.pop_back();
+		lock_guard<mutex> lock(g_stream_lock);
+		if (line == "binary") client->binary = true;
+		else if (line == "json") client->binary = false;
+	}
+	if (client->input.size() > 1024) client->input.clear();
+	return true;
+}
+static bool write_client(stream_client* client) {
+	// Everything queued since the last write goes out in one send, however many records that is.
+	if (client->sent == client->outgoing.size()) {
+		client->outgoing.clear();
+		client->sent = 0;
+		lock_guard<mutex> lock(g_stream_lock);
+		swap(client->outgoing, client->pending);
+	}
+	while (client->sent < client->outgoing.size()) {
+#ifdef MSG_NOSIGNAL
+		ssize_t sent = send(client->fd, client->outgoing.data() + client->sent, client->outgoing.size() - client->sent, MSG_NOSIGNAL);
+#else
+		ssize_t sent = send(client->fd, client->outgoing.data() + client->sent, client->outgoing.size() - client->sent, 0);
+#endif
+		if (sent < 0) return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+		client->sent += sent;
+	}
+	return true;
+}
+void* stream_thread(void* arg) {
+	os_set_thread_name("accessibility: event stream");
+	vector<pollfd> fds;
+	vector<stream_client*> polled;
+	while (g_stream_running) {
+		fds.assign({{g_stream_wake[0], POLLIN, 0}, {g_stream_listener, POLLIN, 0}});
+		polled.clear();
+		{
+			lock_guard<mutex> lock(g_stream_lock);
+			for (const auto& client : g_stream_clients) {
+				bool waiting = client->sent < client->outgoing.size() || !client->pending.empty();
+				fds.push_back({client->fd, short(POLLIN | (waiting? POLLOUT : 0)), 0});
+				polled.push_back(client.get());
+			}
+		}
+		if (poll(fds.data(), fds.size(), -1) < 0) {
+			if (errno == EINTR) continue;
+			obs_log(LOG_WARNING, "event stream poll failed: %s", strerror(errno));
+			break;
+		}
+		if (fds[0].revents & POLLIN) {
+			char buffer[64];
+			while (read(g_stream_wake[0], buffer, sizeof(buffer)) > 0) {}
+		}
+		for (size_t i = 0; i < polled.size(); i++) {
+			short events = fds[i + 2].revents;
+			bool keep = !(events & (POLLERR | POLLNVAL));
+			if (keep && (events & (POLLIN | POLLHUP))) keep = read_client(polled[i]);
+			if (keep && (events & POLLOUT)) keep = write_client(polled[i]);
+			if (!keep) remove_client(polled[i]);
+		}
+		if (fds[1].revents & POLLIN) while (accept_client()) {}
+	}
+	return nullptr;
+}
+static void close_stream() {
+	// Call with g_stream_state_lock held.
+	if (g_stream_listener >= 0) close(g_stream_listener);
+	for (int& fd : g_stream_wake) {
+		if (fd >= 0) close(fd);
+		fd = -1;
+	}
+	g_stream_listener = -1;
+	if (!g_stream_path.empty()) unlink(g_stream_path.c_str());
+	g_stream_path.clear();
+}
+static bool start_stream() {
+	// Call with g_stream_state_lock held.
+	string path = get_event_stream_path();
+	sockaddr_un address = {};
+	address.sun_family = AF_UNIX;
+	if (path.size() >= sizeof(address.sun_path)) {
+		obs_log(LOG_WARNING, "event stream path %s is too long for a socket", path.c_str());
+		return false;
+	}
+	memcpy(address.sun_path, path.c_str(), path.size() + 1);
+	int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (fd < 0) return false;
+	// A socket left over from a crash is replaced, one that still answers belongs to another running copy of OBS.
+	if (connect(fd, (sockaddr*)&address, sizeof(address)) == 0) {
+		obs_log(LOG_WARNING, "event stream %s is already in use", path.c_str());
+		close(fd);
+		return false;
+	}
+	unlink(path.c_str());
+	bool bound = ::bind(fd, (sockaddr*)&address, sizeof(address)) == 0;
+	// Only the user running OBS may connect, nobody can before listen() anyway.
+	if (!bound || chmod(path.c_str(), S_IRUSR | S_IWUSR) != 0 || listen(fd, EVENT_STREAM_MAX_CLIENTS) != 0 || pipe(g_stream_wake) != 0) {
+		obs_log(LOG_WARNING, "event stream %s could not be opened: %s", path.c_str(), strerror(errno));
+		close(fd);
+		if (bound) unlink(path.c_str());
+		return false;
+	}
+	g_stream_listener = fd;
+	g_stream_path = path;
+	set_nonblocking(fd);
+	set_nonblocking(g_stream_wake[0]);
+	set_nonblocking(g_stream_wake[1]);
+	g_stream_running = true;
+	if (pthread_create(&g_stream_thread, nullptr, stream_thread, nullptr) != 0) {
+		g_stream_running = false;
+		close_stream();
+		return false;
+	}
+	obs_log(LOG_INFO, "event stream listening on %s", path.c_str());
+	return true;
+}
+static void stop_stream() {
+	// Call with g_stream_state_lock held.
+	if (!g_stream_running) return;
+	g_stream_running = false;
+	wake_stream();
+	pthread_join(g_stream_thread, nullptr);
+	{
+		lock_guard<mutex> lock(g_stream_lock);
+		for (const auto& client : g_stream_clients) close(client->fd);
+		g_stream_clients.clear();
+		g_stream_client_count = 0;
+	}
+	close_stream();
+}
+
+void set_event_stream(bool enabled) {
+	lock_guard<mutex> lock(g_stream_state_lock);
+	if (enabled && !g_stream_running) start_stream();
+	else if (!enabled) stop_stream();
+}
+void shutdown_event_stream() {
+	set_event_stream(false);
+}
+bool event_stream_active() {
+	return g_stream_client_count.load(memory_order_relaxed) > 0;
+}
+void publish_event(const event_type* event, const string& message, obs_source_t* source) {
+	if (!event_stream_active()) return;
+	uint64_t timestamp = chrono::duration_cast<chrono::nanoseconds>(chrono::system_clock::now().time_since_epoch()).count();
+	const char* name = source? obs_source_get_name(source) : nullptr;
+	const char* uuid = source? obs_source_get_uuid(source) : nullptr;
+	string source_name = name? name : "", source_uuid = uuid? uuid : "";
+	string json, binary; // Each layout is encoded at most once, however many clients want it.
+	bool wake = false;
+	lock_guard<mutex> lock(g_stream_lock);
+	for (const auto& client : g_stream_clients) {
+		string& record = client->binary? binary : json;
+		if (record.empty() && client->binary) {
+			record.assign(4, '\0');
+			record += char(STREAM_RECORD_EVENT);
+			append_integer(record, timestamp, 8);
+			append_binary_string(record, event->get_id(), 2);
+			append_binary_string(record, source_name, 2);
+			append_binary_string(record, source_uuid, 2);
+			append_binary_string(record, message, 4);
+			finish_binary_record(record);
+		} else if (record.empty()) {
+			record = "{\"type\":\"event\",";
+			append_json_string(record, "event", event->get_id());
+			append_json_string(record, "message", message);
+			if (source) {
+				append_json_string(record, "source", source_name);
+				append_json_string(record, "source_uuid", source_uuid);
+			}
+			record += format("\"timestamp\":{}}}\n", timestamp);
+		}
+		// A client that fell behind is told how much it missed ahead of the first record it does get.
+		string dropped = client->unreported? encode_dropped(client->unreported, client->binary) : "";
+		if (client->pending.size() + dropped.size() + record.size() > EVENT_STREAM_CLIENT_BUFFER) {
+			client->unreported++;
+			g_stream_dropped.fetch_add(1, memory_order_relaxed);
+			continue;
+		}
+		if (client->pending.empty()) wake = true;
+		client->pending += dropped;
+		client->pending += record;
+		client->unreported = 0;
+	}
+	g_stream_published.fetch_add(1, memory_order_relaxed);
+	if (wake) wake_stream();
+}
+event_stream_stats get_event_stream_stats() {
+	return {g_stream_client_count.load(), g_stream_published.load(), g_stream_dropped.load()};
+}
+#else
+// Windows has no equivalent wired up yet, so the setting is hidden there and the stream never opens.
+void set_event_stream(bool enabled) {
+	if (enabled) obs_log(LOG_WARNING, "the event stream is not available on Windows");
+}
+void shutdown_event_stream() {}
+bool event_stream_active() { return false; }
+void publish_event(const event_type* event, const string& message, obs_source_t* source) {}
+event_stream_stats get_event_stream_stats() { return {0, 0, 0}; }
+#endif
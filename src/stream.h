@@ -0,0 +1,41 @@
+/*
+ OBS Accessibility
+ Copyright (C) 2025 Sam Tupy Productions <webmaster@samtupy.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along
+ with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#pragma once
+#include <cstdint>
+#include <string>
+#include <obs.h>
+#include "events.h"
+
+#define EVENT_STREAM_MAX_CLIENTS 16
+#define EVENT_STREAM_CLIENT_BUFFER 262144 // Bytes of records a client may have waiting before further records are dropped for it.
+
+struct event_stream_stats {
+	uint64_t clients;
+	uint64_t published; // Events encoded for at least one client.
+	uint64_t dropped; // Records dropped because a client's queue was full, summed over clients.
+};
+
+// Publishes announced events on a local socket for braille displays, screen reader scripts and other tools. Clients receive newline delimited JSON until they send a line reading "binary", after which records are length prefixed, see README.md for both layouts.
+void set_event_stream(bool enabled);
+void shutdown_event_stream();
+bool event_stream_active(); // Whether anyone is connected, so callers can skip work only a subscriber would need.
+// Queues a record for every client without blocking on any of them, source may be null.
+void publish_event(const event_type* event, const std::string& message, obs_source_t* source);
+std::string get_event_stream_path();
+event_stream_stats get_event_stream_stats();
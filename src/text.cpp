@@ -16,8 +16,11 @@
  with this program. If not, see <https://www.gnu.org/licenses/>
 */
 
+#include <cmath>
 #include <fmt/format.h>
 #include <obs-module.h>
+#include "monitor.h"
+#include "scenes.h"
 #include "text.h"
 
 using namespace std;
@@ -47,6 +50,21 @@ string obs_source_identify(obs_source_t* src) {
 	string id = obs_source_get_id(src);
 	return format("{}({})", id, name);
 }
+string describe_scene_items(obs_source_t* scene) {
+	// Read from the scene mirror, so a scene with hundreds of sources is described without locking it.
+	vector<scene_item_state> items;
+	if (!get_scene_items(scene, items)) return _t("scene_item.unavailable");
+	if (items.empty()) return _t("scene_item.none");
+	string output;
+	for (const scene_item_state& item : items) {
+		if (!output.empty()) output += ". ";
+		output += item.name;
+		if (!item.visible) output += _t("scene_item.hidden");
+		if (item.has_audio && item.muted) output += _t("scene_item.muted");
+		else if (item.has_audio && item.volume < 0.995f) output += format(runtime(_t("scene_item.volume")), int(item.volume * 100 + 0.5f));
+	}
+	return output;
+}
 string get_obs_source_variable(const string& variable, obs_source_t* src, const string& if_true = "true", const string& if_false = "false") {
 	if (!src) return _t("source_invalid");
 	if (variable == "name") return obs_source_get_name(src);
@@ -57,9 +75,35 @@ string get_obs_source_variable(const string& variable, obs_source_t* src, const
 	else if (variable == "volume%") return format("{}", int(obs_source_get_volume(src) * 100));
 	else if (variable == "balance") return format("{}", obs_source_get_balance_value(src));
 	else if (variable == "balance%") return format("{}", int(obs_source_get_balance_value(src) * 100));
+	else if (variable == "items") return describe_scene_items(src);
 	else return format(runtime(_t("object_variable_invalid")), variable, obs_source_identify(src));
 }
-string get_obs_variables(string variable, const calldata_t* data = nullptr, const string& string_id = "") {
+string format_duration(uint64_t ns) {
+	uint64_t seconds = ns / 1000000000;
+	return format("{}:{:02}:{:02}", seconds / 3600, seconds / 60 % 60, seconds % 60);
+}
+string get_obs_stats_variable(const string& variable, const string& if_true = "true", const string& if_false = "false") {
+	// Served from the monitor's last sample, so a template never waits on the outputs themselves.
+	obs_stats stats = get_obs_stats();
+	if (variable == "stream.active") return stats.streaming? if_true : if_false;
+	else if (variable == "stream.reconnecting") return stats.stream_reconnecting? if_true : if_false;
+	else if (variable == "stream.bitrate") return format("{}", llround(stats.stream_kbps));
+	else if (variable == "stream.dropped") return format("{}", stats.stream_dropped);
+	else if (variable == "stream.dropped%") return format("{:.1f}", stats.stream_frames? stats.stream_dropped * 100.0 / stats.stream_frames : 0.0);
+	else if (variable == "stream.congestion%") return format("{}", int(stats.stream_congestion * 100));
+	else if (variable == "stream.duration") return format_duration(stats.stream_duration_ns);
+	else if (variable == "record.active") return stats.recording? if_true : if_false;
+	else if (variable == "record.bitrate") return format("{}", llround(stats.record_kbps));
+	else if (variable == "record.duration") return format_duration(stats.record_duration_ns);
+	else if (variable == "record.size") return format("{:.1f}", stats.record_bytes / 1048576.0);
+	else if (variable == "stats.cpu") return format("{:.1f}", stats.cpu);
+	else if (variable == "stats.memory") return format("{}", stats.memory / 1048576);
+	else if (variable == "stats.fps") return format("{:.0f}", stats.fps);
+	else if (variable == "stats.frame_time") return format("{:.1f}", stats.frame_time_ms);
+	else if (variable == "stats.render_lag%") return format("{:.1f}", stats.render_lag * 100);
+	else return format(runtime(_t("variable_invalid")), variable);
+}
+string get_obs_variables(string variable, const calldata_t* data = nullptr, const string& string_id = "", obs_source_t* scene_override = nullptr) {
 	if (variable == "id") return string_id;
 	string if_true = "true", if_false = "false";
 	size_t pos = find_unescaped(variable, ":");
@@ -72,15 +116,27 @@ string get_obs_variables(string variable, const calldata_t* data = nullptr, cons
 		if_false = conditionals.substr(pos + 1);
 	}
 	if (variable.starts_with("scene.")) {
-		obs_source_t* scene = obs_frontend_get_current_scene();
+		obs_source_t* scene = scene_override? obs_source_get_ref(scene_override) : obs_frontend_get_current_scene();
 		if (!scene) return format(runtime(_t("scene_invalid")), variable);
 		string output = get_obs_source_variable(variable.substr(6), scene);
 		obs_source_release(scene);
 		return output;
+	} else if (variable.starts_with("preview.")) {
+		obs_source_t* scene = obs_frontend_get_current_preview_scene();
+		if (!scene) return variable == "preview.name"? _t("preview_invalid") : "";
+		string output = get_obs_source_variable(variable.substr(8), scene);
+		obs_source_release(scene);
+		return output;
 	} else if (variable == "tbar") return to_string(obs_frontend_get_tbar_position());
+	else if (variable.starts_with("stream.") || variable.starts_with("record.") || variable.starts_with("stats.")) return get_obs_stats_variable(variable, if_true, if_false);
 	else if (data) {
-		if (variable.starts_with("source.")) return get_obs_source_variable(variable.substr(7), GetCalldataPointer<obs_source_t>(data, "source"));
-		if (variable.starts_with("filter.")) return get_obs_source_variable(variable.substr(7), GetCalldataPointer<obs_source_t>(data, "filter"));
+		if (variable.starts_with("source.") || variable.starts_with("filter.")) {
+			obs_source_t* src = GetCalldataPointer<obs_source_t>(data, variable.starts_with("source.")? "source" : "filter");
+			// A source that was already being destroyed when its event was queued leaves only its identity behind, see copy_calldata() in dispatch.cpp.
+			const char* identity = src? nullptr : calldata_string(data, variable.c_str());
+			if (identity) return identity;
+			return get_obs_source_variable(variable.substr(7), src);
+		}
 		bool calldata_b = false;
 		const char* calldata_s = calldata_string(data, variable.c_str());
 		if (calldata_s) return calldata_s;
@@ -88,7 +144,16 @@ string get_obs_variables(string variable, const calldata_t* data = nullptr, cons
 	}
 	return format(runtime(_t("variable_invalid")), variable);
 }
-string replace_obs_variables(string text, const calldata_t* data) {
+bool uses_only_variables(const string& text, std::string_view prefix) {
+	bool escape_sequence = false;
+	for (size_t i = 0; i < text.size(); i++) {
+		if (escape_sequence) escape_sequence = false;
+		else if (text[i] == '\\') escape_sequence = true;
+		else if (text[i] == '{' && text.compare(i + 1, prefix.size(), prefix) != 0) return false;
+	}
+	return true;
+}
+string replace_obs_variables(string text, const calldata_t* data, obs_source_t* scene) {
 	// Replace sequences such as {source.name} with their proper data.
 	bool escape_sequence = false;
 	size_t brace_level = 0, replacement_start = 0;
@@ -110,7 +175,7 @@ string replace_obs_variables(string text, const calldata_t* data) {
 		} else if (c == '}') {
 			brace_level -= 1;
 			if (brace_level) continue;
-			text.replace(replacement_start, i - replacement_start + 1, get_obs_variables(text.substr(replacement_start + 1, i - replacement_start -1), data));
+			text.replace(replacement_start, i - replacement_start + 1, get_obs_variables(text.substr(replacement_start + 1, i - replacement_start -1), data, "", scene));
 			i = replacement_start -1;
 		}
 	}
@@ -18,7 +18,9 @@
 
 #pragma once
 #include <string>
+#include <string_view>
 #include <obs-frontend-api.h>
 
 std::string _t(const std::string& string_id, const std::string& default_value = "{id}");
-std::string replace_obs_variables(std::string text, const calldata_t* calldata);
+std::string replace_obs_variables(std::string text, const calldata_t* calldata, obs_source_t* scene = nullptr); // A scene given here stands in for the current scene.
+bool uses_only_variables(const std::string& text, std::string_view prefix); // True if every variable in text, including any nested in another's conditional text, starts with prefix.
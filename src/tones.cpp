@@ -0,0 +1,176 @@
+/*
+ OBS Accessibility
+ Copyright (C) 2025 Sam Tupy Productions <webmaster@samtupy.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along
+ with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include "tones.h"
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#include <emmintrin.h>
+	#define TONES_SSE2
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+	#include <arm_neon.h>
+	#define TONES_NEON
+#endif
+
+using namespace std;
+
+#define TONE_RATE 48000
+#define TONE_PI 3.14159265358979f
+
+static string trim(const string& text) {
+	size_t start = text.find_first_not_of(" \t"), end = text.find_last_not_of(" \t");
+	return start == string::npos? "" : text.substr(start, end - start + 1);
+}
+static bool parse_number(const string& text, float& out) {
+	if (text.empty()) return false;
+	char* end = nullptr;
+	out = strtof(text.c_str(), &end);
+	return end && !*end && isfinite(out);
+}
+bool parse_tone_spec(const string& text, tone_spec& out) {
+	out = tone_spec();
+	string rest = trim(text);
+	if (rest.empty()) return true;
+	size_t space = rest.find_first_of(" \t");
+	string mode = rest.substr(0, space);
+	transform(mode.begin(), mode.end(), mode.begin(), [](unsigned char c) { return tolower(c); });
+	if (mode != "pitch" && mode != "pan") return false;
+	rest = space == string::npos? "" : trim(rest.substr(space));
+	// The range is optional, it is taken from the last two words when both are numbers.
+	size_t high_start = rest.find_last_of(" \t");
+	size_t low_start = high_start == string::npos? string::npos : rest.find_last_of(" \t", rest.find_last_not_of(" \t", high_start));
+	float low, high;
+	if (low_start != string::npos && parse_number(trim(rest.substr(low_start, high_start - low_start)), low) && parse_number(rest.substr(high_start + 1), high)) {
+		if (low == high) return false;
+		out.low = low;
+		out.high = high;
+		rest = trim(rest.substr(0, low_start));
+	}
+	if (rest.empty()) return false;
+	out.mode = mode == "pitch"? TONE_PITCH : TONE_PAN;
+	out.value = rest;
+	return true;
+}
+bool tone_position(const tone_spec& spec, const string& rendered, float& position) {
+	float value;
+	if (!parse_number(trim(rendered), value)) return false;
+	position = clamp((value - spec.low) / (spec.high - spec.low), 0.0f, 1.0f);
+	return true;
+}
+bool trigger_tone(tone_bank* bank, const tone_spec& spec, float position, uint64_t start_frame) {
+	uint32_t tail = bank->queue_tail.load(memory_order_relaxed);
+	if (tail - bank->queue_head.load(memory_order_acquire) >= TONE_QUEUE_SIZE) return false;
+	tone_trigger& trigger = bank->queue[tail & (TONE_QUEUE_SIZE - 1)];
+	trigger.frequency = spec.mode == TONE_PITCH? TONE_LOW_HZ * powf(TONE_HIGH_HZ / TONE_LOW_HZ, position) : TONE_PAN_HZ;
+	trigger.pan = spec.mode == TONE_PAN? position * 2.0f - 1.0f : 0.0f;
+	trigger.start_frame = start_frame;
+	bank->queue_tail.store(tail + 1, memory_order_release);
+	return true;
+}
+static void start_tones(tone_bank* bank, uint64_t block_frame, uint32_t frames) {
+	// Takes every trigger due to start within this block, later ones wait in the ring.
+	uint32_t head = bank->queue_head.load(memory_order_relaxed), tail = bank->queue_tail.load(memory_order_acquire);
+	for (; head != tail; head++) {
+		const tone_trigger& trigger = bank->queue[head & (TONE_QUEUE_SIZE - 1)];
+		if (trigger.start_frame >= block_frame + frames) break;
+		uint32_t v = bank->next_voice;
+		bank->next_voice = (v + 1) % TONE_VOICES;
+		float step = 2.0f * TONE_PI * trigger.frequency / TONE_RATE, angle = (trigger.pan + 1.0f) * TONE_PI / 4.0f; // Constant power panning.
+		bank->x[v] = 1.0f;
+		bank->y[v] = 0.0f;
+		bank->cos_step[v] = cosf(step);
+		bank->sin_step[v] = sinf(step);
+		bank->age[v] = trigger.start_frame > block_frame? -float(trigger.start_frame - block_frame) : 0.0f; // The envelope stays shut until the exact start frame.
+		bank->length[v] = TONE_MS * TONE_RATE / 1000.0f;
+		bank->left[v] = cosf(angle) * TONE_GAIN;
+		bank->right[v] = sinf(angle) * TONE_GAIN;
+	}
+	bank->queue_head.store(head, memory_order_release);
+}
+static void render_tone_group(tone_bank* bank, size_t g, float* interleaved, uint32_t frames) {
+	// Four voices at a time. Each frame rotates every voice's point by its step and scales its height by an envelope that rises over the attack and falls over the release, clamped to silence outside the tone.
+	const float attack = 1000.0f / (TONE_ATTACK_MS * TONE_RATE), release = 1000.0f / (TONE_RELEASE_MS * TONE_RATE);
+	uint32_t f = 0;
+	#if defined(TONES_SSE2)
+		__m128 x = _mm_load_ps(bank->x + g), y = _mm_load_ps(bank->y + g), c = _mm_load_ps(bank->cos_step + g), s = _mm_load_ps(bank->sin_step + g);
+		__m128 age = _mm_load_ps(bank->age + g), length = _mm_load_ps(bank->length + g), left = _mm_load_ps(bank->left + g), right = _mm_load_ps(bank->right + g);
+		const __m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1.0f), attack4 = _mm_set1_ps(attack), release4 = _mm_set1_ps(release);
+		for (; f < frames; f++) {
+			__m128 next_x = _mm_sub_ps(_mm_mul_ps(x, c), _mm_mul_ps(y, s));
+			y = _mm_add_ps(_mm_mul_ps(x, s), _mm_mul_ps(y, c));
+			x = next_x;
+			__m128 envelope = _mm_min_ps(_mm_max_ps(_mm_min_ps(_mm_mul_ps(age, attack4), _mm_mul_ps(_mm_sub_ps(length, age), release4)), zero), one);
+			__m128 out = _mm_mul_ps(y, envelope), l = _mm_mul_ps(out, left), r = _mm_mul_ps(out, right);
+			// Sums the four lanes of each channel at once, leaving left and right in the low two lanes.
+			__m128 sums = _mm_add_ps(_mm_unpacklo_ps(l, r), _mm_unpackhi_ps(l, r));
+			sums = _mm_add_ps(sums, _mm_movehl_ps(sums, sums));
+			__m128 frame = _mm_loadl_pi(zero, (const __m64*)(interleaved + f * 2));
+			_mm_storel_pi((__m64*)(interleaved + f * 2), _mm_add_ps(frame, sums));
+			age = _mm_add_ps(age, one);
+		}
+		_mm_store_ps(bank->x + g, x);
+		_mm_store_ps(bank->y + g, y);
+		_mm_store_ps(bank->age + g, age);
+	#elif defined(TONES_NEON)
+		float32x4_t x = vld1q_f32(bank->x + g), y = vld1q_f32(bank->y + g), c = vld1q_f32(bank->cos_step + g), s = vld1q_f32(bank->sin_step + g);
+		float32x4_t age = vld1q_f32(bank->age + g), length = vld1q_f32(bank->length + g), left = vld1q_f32(bank->left + g), right = vld1q_f32(bank->right + g);
+		const float32x4_t zero = vdupq_n_f32(0.0f), one = vdupq_n_f32(1.0f), attack4 = vdupq_n_f32(attack), release4 = vdupq_n_f32(release);
+		for (; f < frames; f++) {
+			float32x4_t next_x = vfmsq_f32(vmulq_f32(x, c), y, s);
+			y = vfmaq_f32(vmulq_f32(x, s), y, c);
+			x = next_x;
+			float32x4_t envelope = vminq_f32(vmaxq_f32(vminq_f32(vmulq_f32(age, attack4), vmulq_f32(vsubq_f32(length, age), release4)), zero), one);
+			float32x4_t out = vmulq_f32(y, envelope);
+			interleaved[f * 2] += vaddvq_f32(vmulq_f32(out, left));
+			interleaved[f * 2 + 1] += vaddvq_f32(vmulq_f32(out, right));
+			age = vaddq_f32(age, one);
+		}
+		vst1q_f32(bank->x + g, x);
+		vst1q_f32(bank->y + g, y);
+		vst1q_f32(bank->age + g, age);
+	#endif
+	for (; f < frames; f++) {
+		for (size_t v = g; v < g + 4; v++) {
+			float next_x = bank->x[v] * bank->cos_step[v] - bank->y[v] * bank->sin_step[v];
+			bank->y[v] = bank->x[v] * bank->sin_step[v] + bank->y[v] * bank->cos_step[v];
+			bank->x[v] = next_x;
+			float envelope = clamp(min(bank->age[v] * attack, (bank->length[v] - bank->age[v]) * release), 0.0f, 1.0f);
+			interleaved[f * 2] += bank->y[v] * envelope * bank->left[v];
+			interleaved[f * 2 + 1] += bank->y[v] * envelope * bank->right[v];
+			bank->age[v] += 1.0f;
+		}
+	}
+	for (size_t v = g; v < g + 4; v++) {
+		// Rounding slowly changes the radius the points rotate at, pulling them back onto the unit circle once a block keeps the level steady.
+		float radius = sqrtf(bank->x[v] * bank->x[v] + bank->y[v] * bank->y[v]);
+		if (radius > 0.0f) {
+			bank->x[v] /= radius;
+			bank->y[v] /= radius;
+		}
+	}
+}
+void render_tones(tone_bank* bank, float* interleaved, uint32_t frames, uint64_t block_frame) {
+	start_tones(bank, block_frame, frames);
+	for (size_t g = 0; g < TONE_VOICES; g += 4) {
+		// Groups with nothing sounding are skipped, so an idle bank costs a few comparisons per block.
+		bool sounding = false;
+		for (size_t v = g; v < g + 4 && !sounding; v++) sounding = bank->age[v] < bank->length[v];
+		if (sounding) render_tone_group(bank, g, interleaved, frames);
+	}
+}
@@ -0,0 +1,70 @@
+/*
+ OBS Accessibility
+ Copyright (C) 2025 Sam Tupy Productions <webmaster@samtupy.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along
+ with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#define TONE_VOICES 16 // Tones that can sound at once per event source, must be a multiple of four.
+#define TONE_QUEUE_SIZE 64 // Triggers waiting for the mixer, must be a power of two.
+#define TONE_LOW_HZ 220.0f // Pitch mode spans the three octaves from here to TONE_HIGH_HZ, evenly in musical steps.
+#define TONE_HIGH_HZ 1760.0f
+#define TONE_PAN_HZ 660.0f // Pan mode keeps to one pitch.
+#define TONE_MS 60 // Length of each tone, including its envelope.
+#define TONE_ATTACK_MS 3
+#define TONE_RELEASE_MS 40
+#define TONE_GAIN 0.2f
+
+enum tone_mode {
+	TONE_OFF,
+	TONE_PITCH, // Higher values play higher.
+	TONE_PAN, // Low values play on the left, high ones on the right.
+};
+
+// A value earcon as configured for an event, such as "pitch {tbar} 0 1023": the mode, a template that renders to a number, and the range it is mapped from.
+struct tone_spec {
+	tone_mode mode = TONE_OFF;
+	std::string value;
+	float low = 0.0f, high = 100.0f;
+};
+bool parse_tone_spec(const std::string& text, tone_spec& out); // An empty text parses as TONE_OFF.
+bool tone_position(const tone_spec& spec, const std::string& rendered, float& position); // Maps a rendered value into 0 to 1, false if it isn't a number.
+
+struct tone_trigger {
+	float frequency;
+	float pan; // -1 to 1.
+	uint64_t start_frame; // Engine frame to start on, or 0 for the next block.
+};
+// Sine voices synthesized inside an event source's mixer, kept as arrays of lanes so that four voices advance per instruction with SSE2 or NEON. Triggers pass through a single producer, single consumer ring, so starting a tone never allocates or waits on the mixer.
+struct tone_bank {
+	alignas(16) float x[TONE_VOICES]; // Each voice is a point rotating around the unit circle once per cycle.
+	alignas(16) float y[TONE_VOICES];
+	alignas(16) float cos_step[TONE_VOICES];
+	alignas(16) float sin_step[TONE_VOICES];
+	alignas(16) float age[TONE_VOICES]; // Frames since the voice started, negative until its start frame.
+	alignas(16) float length[TONE_VOICES];
+	alignas(16) float left[TONE_VOICES]; // Gain per channel, 0 for voices that have never been used.
+	alignas(16) float right[TONE_VOICES];
+	uint32_t next_voice; // Voices are reused round robin, so the oldest tone is the one cut off.
+	tone_trigger queue[TONE_QUEUE_SIZE];
+	std::atomic<uint32_t> queue_head; // Next trigger the mixer takes.
+	std::atomic<uint32_t> queue_tail; // Next free slot for the producer.
+};
+bool trigger_tone(tone_bank* bank, const tone_spec& spec, float position, uint64_t start_frame); // One producer at a time, false if the ring is full.
+void render_tones(tone_bank* bank, float* interleaved, uint32_t frames, uint64_t block_frame); // Adds any sounding tones into a block of stereo samples starting at engine frame block_frame.
@@ -0,0 +1,161 @@
+/*
+ OBS Accessibility
+ Copyright (C) 2025 Sam Tupy Productions <webmaster@samtupy.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along
+ with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <obs.h>
+#include "dispatch.h"
+#include "events.h"
+#include "monitor.h"
+#include "video.h"
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#include <emmintrin.h>
+	#define VIDEO_SSE2
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+	#include <arm_neon.h>
+	#define VIDEO_NEON
+#endif
+
+using namespace std;
+
+video_frame_stats measure_video_frame(const uint8_t* luma, uint32_t linesize, const uint8_t* previous, uint32_t previous_linesize, uint32_t width, uint32_t height) {
+	// Sums of luma and of absolute differences, 16 pixels at a time with the byte wise sum of absolute differences instructions.
+	uint64_t sum = 0, difference = 0;
+	for (uint32_t y = 0; y < height; y++) {
+		const uint8_t* row = luma + size_t(y) * linesize;
+		const uint8_t* previous_row = previous? previous + size_t(y) * previous_linesize : nullptr;
+		uint32_t x = 0;
+		#if defined(VIDEO_SSE2)
+			const __m128i zero = _mm_setzero_si128();
+			__m128i row_sum = zero, row_difference = zero;
+			for (; x + 16 <= width; x += 16) {
+				__m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + x));
+				row_sum = _mm_add_epi64(row_sum, _mm_sad_epu8(pixels, zero));
+				if (previous_row) row_difference = _mm_add_epi64(row_difference, _mm_sad_epu8(pixels, _mm_loadu_si128(reinterpret_cast<const __m128i*>(previous_row + x))));
+			}
+			uint64_t lanes[2];
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), row_sum);
+			sum += lanes[0] + lanes[1];
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), row_difference);
+			difference += lanes[0] + lanes[1];
+		#elif defined(VIDEO_NEON)
+			uint32x4_t row_sum = vdupq_n_u32(0), row_difference = vdupq_n_u32(0);
+			for (; x + 16 <= width; x += 16) {
+				uint8x16_t pixels = vld1q_u8(row + x);
+				row_sum = vpadalq_u16(row_sum, vpaddlq_u8(pixels));
+				if (previous_row) row_difference = vpadalq_u16(row_difference, vpaddlq_u8(vabdq_u8(pixels, vld1q_u8(previous_row + x))));
+			}
+			sum += vaddvq_u32(row_sum);
+			difference += vaddvq_u32(row_difference);
+		#endif
+		for (; x < width; x++) {
+			sum += row[x];
+			if (previous_row) difference += row[x] > previous_row[x]? row[x] - previous_row[x] : previous_row[x] - row[x];
+		}
+	}
+	double pixels = double(width) * height;
+	return {pixels? sum / pixels : 0.0, pixels && previous? difference / pixels : 0.0};
+}
+
+// The last analyzed frame and how long output has looked wrong, only touched by the video thread while the callback is registered.
+uint8_t g_video_previous[VIDEO_MONITOR_WIDTH * VIDEO_MONITOR_HEIGHT];
+bool g_video_has_previous = false, g_video_black = false, g_video_frozen = false;
+uint64_t g_video_black_since = 0, g_video_frozen_since = 0;
+event_type* g_video_reported = nullptr; // Whichever of video_black or video_frozen was last announced, until video_restored.
+mutex g_video_lock; // Guards the flags below, which decide whether the callback is registered.
+bool g_video_enabled = false, g_video_ready = false, g_video_attached = false;
+atomic<event_type*> g_video_black_event = nullptr, g_video_frozen_event = nullptr, g_video_restored_event = nullptr;
+static bool announce_video_event(event_type* event) {
+	if (!event || !event->is_active()) return false;
+	if (event->is_low_priority() && is_shedding_load()) {
+		count_shed_event();
+		return false;
+	}
+	return dispatch_event(event, nullptr);
+}
+static void on_video_frame(void*, struct video_data* frame) {
+	if (!frame || !frame->data[0]) return;
+	video_frame_stats stats = measure_video_frame(frame->data[0], frame->linesize[0], g_video_has_previous? g_video_previous : nullptr, VIDEO_MONITOR_WIDTH, VIDEO_MONITOR_WIDTH, VIDEO_MONITOR_HEIGHT);
+	bool black = stats.luma <= VIDEO_BLACK_LUMA;
+	bool frozen = !black && g_video_has_previous && stats.difference <= VIDEO_FROZEN_DIFFERENCE;
+	for (uint32_t y = 0; y < VIDEO_MONITOR_HEIGHT; y++) memcpy(g_video_previous + y * VIDEO_MONITOR_WIDTH, frame->data[0] + size_t(y) * frame->linesize[0], VIDEO_MONITOR_WIDTH);
+	g_video_has_previous = true;
+	if (black && !g_video_black) g_video_black_since = frame->timestamp;
+	if (frozen && !g_video_frozen) g_video_frozen_since = frame->timestamp;
+	g_video_black = black;
+	g_video_frozen = frozen;
+	event_type* black_event = g_video_black_event.load(memory_order_acquire);
+	event_type* frozen_event = g_video_frozen_event.load(memory_order_acquire);
+	if ((g_video_reported == black_event && !black) || (g_video_reported == frozen_event && !frozen)) {
+		g_video_reported = nullptr;
+		announce_video_event(g_video_restored_event.load(memory_order_acquire));
+	}
+	if (g_video_reported) return;
+	if (black && frame->timestamp - g_video_black_since >= uint64_t(VIDEO_BLACK_SECONDS * 1000000000)) {
+		g_video_reported = black_event;
+		announce_video_event(black_event);
+	} else if (frozen && frame->timestamp - g_video_frozen_since >= uint64_t(VIDEO_FROZEN_SECONDS * 1000000000)) {
+		g_video_reported = frozen_event;
+		announce_video_event(frozen_event);
+	}
+}
+static void update_video_callback() {
+	// Call with g_video_lock held.
+	bool attach = g_video_enabled && g_video_ready;
+	if (attach == g_video_attached) return;
+	if (attach) {
+		g_video_has_previous = g_video_black = g_video_frozen = false;
+		g_video_reported = nullptr;
+		video_scale_info conversion = {};
+		conversion.format = VIDEO_FORMAT_Y800;
+		conversion.width = VIDEO_MONITOR_WIDTH;
+		conversion.height = VIDEO_MONITOR_HEIGHT;
+		conversion.range = VIDEO_RANGE_FULL;
+		obs_add_raw_video_callback2(&conversion, VIDEO_MONITOR_DIVISOR, on_video_frame, nullptr);
+	} else obs_remove_raw_video_callback(on_video_frame, nullptr);
+	g_video_attached = attach;
+}
+static void on_video_reset(void*, calldata_t*) {
+	// A video reset replaces the output the callback was registered with, so register it again with the new one.
+	lock_guard<mutex> lock(g_video_lock);
+	if (!g_video_attached) return;
+	obs_remove_raw_video_callback(on_video_frame, nullptr);
+	g_video_attached = false;
+	update_video_callback();
+}
+void set_video_monitor(bool enabled) {
+	lock_guard<mutex> lock(g_video_lock);
+	g_video_enabled = enabled;
+	update_video_callback();
+}
+void init_video_monitor() {
+	g_video_black_event = get_event_type(std::string_view("video_black"));
+	g_video_frozen_event = get_event_type(std::string_view("video_frozen"));
+	g_video_restored_event = get_event_type(std::string_view("video_restored"));
+	signal_handler_connect(obs_get_signal_handler(), "video_reset", on_video_reset, nullptr);
+	lock_guard<mutex> lock(g_video_lock);
+	g_video_ready = true;
+	update_video_callback();
+}
+void shutdown_video_monitor() {
+	signal_handler_disconnect(obs_get_signal_handler(), "video_reset", on_video_reset, nullptr);
+	lock_guard<mutex> lock(g_video_lock);
+	g_video_ready = false;
+	update_video_callback();
+}
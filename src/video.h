@@ -0,0 +1,41 @@
+/*
+ OBS Accessibility
+ Copyright (C) 2025 Sam Tupy Productions <webmaster@samtupy.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along
+ with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#pragma once
+#include <cstdint>
+
+#define VIDEO_MONITOR_WIDTH 160 // Program output is scaled down to this on the GPU before it is read back.
+#define VIDEO_MONITOR_HEIGHT 90
+#define VIDEO_MONITOR_DIVISOR 6 // Only every this many frames is read back, 10 a second at 60 fps.
+#define VIDEO_BLACK_LUMA 10.0 // Mean full range luma at or below which a frame counts as black.
+#define VIDEO_FROZEN_DIFFERENCE 0.25 // Mean absolute luma change per pixel from the previous analyzed frame at or below which a frame counts as unchanged.
+#define VIDEO_BLACK_SECONDS 2.0 // How long output must stay black or unchanged before it is announced.
+#define VIDEO_FROZEN_SECONDS 5.0
+
+struct video_frame_stats {
+	double luma; // Mean luma between 0 and 255.
+	double difference; // Mean absolute luma change per pixel from the previous frame, 0 if there was none.
+};
+
+// Measures an 8 bit luma plane with SSE2 or NEON where available. previous may be null, and rows may be padded out to linesize.
+video_frame_stats measure_video_frame(const uint8_t* luma, uint32_t linesize, const uint8_t* previous, uint32_t previous_linesize, uint32_t width, uint32_t height);
+
+// Watches a small, decimated copy of the program output and announces video_black, video_frozen and video_restored.
+void set_video_monitor(bool enabled); // Takes effect immediately if OBS has finished loading, otherwise once init_video_monitor() runs.
+void init_video_monitor(); // Call once OBS has finished loading.
+void shutdown_video_monitor();